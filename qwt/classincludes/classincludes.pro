@@ -87,12 +87,15 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtAbstractLegend \
         QwtCurveFitter \
         QwtEventPattern \
+        QwtHistogramData \
         QwtIntervalSample \
         QwtLegend \
         QwtLegendData \
         QwtLegendLabel \
+        QwtVirtualLegend \
         QwtPointMapper \
         QwtMatrixRasterData \
+        QwtTiledRasterData \
         QwtOHLCSample \
         QwtPlot \
         QwtPlotAbstractBarChart \
@@ -109,6 +112,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotLegendItem \
         QwtPlotMagnifier \
         QwtPlotMarker \
+        QwtPlotMatrix \
         QwtPlotMultiBarChart \
         QwtPlotPanner \
         QwtPlotPicker \
@@ -116,6 +120,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotRenderer \
         QwtPlotRescaler \
         QwtPlotScaleItem \
+        QwtPlotScene \
         QwtPlotSeriesItem \
         QwtPlotShapeItem \
         QwtPlotSpectroCurve \
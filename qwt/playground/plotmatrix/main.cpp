@@ -1,18 +1,19 @@
-#include "plotmatrix.h"
+#include <qwt_plot_matrix.h>
 #include <qwt_plot_grid.h>
+#include <qwt_plot_canvas.h>
 #include <qwt_scale_widget.h>
 #include <qapplication.h>
 #include <qpen.h>
 #include <qmath.h>
 
-class MainWindow: public PlotMatrix
+class MainWindow: public QwtPlotMatrix
 {
 public:
     MainWindow();
 };
 
 MainWindow::MainWindow():
-    PlotMatrix( 3, 4 )
+    QwtPlotMatrix( 3, 4 )
 {
     enableAxis( QwtPlot::yLeft );
     enableAxis( QwtPlot::yRight );
@@ -37,6 +38,12 @@ MainWindow::MainWindow():
         for ( int col = 0; col < numColumns(); col++ )
         {
             QwtPlot *plot = plotAt( row, col );
+
+            QwtPlotCanvas *canvas = new QwtPlotCanvas();
+            canvas->setLineWidth( 1 );
+            canvas->setFrameStyle( QFrame::Box | QFrame::Plain );
+
+            plot->setCanvas( canvas );
             plot->setCanvasBackground( QColor( Qt::darkGray ) );
 
             QwtPlotGrid *grid = new QwtPlotGrid();
@@ -50,7 +57,7 @@ MainWindow::MainWindow():
     plotAt( 1, 0 )->axisWidget( QwtPlot::yLeft )->setLabelRotation( 45 );
     plotAt( 1, numColumns() - 1 )->axisWidget( QwtPlot::yRight )->setLabelRotation( -45 );
 
-    updateLayout();
+    replot();
 }
 
 int main( int argc, char **argv )
@@ -11,9 +11,5 @@ include( $${PWD}/../playground.pri )
 
 TARGET   = plotmatrix
 
-HEADERS = \
-     plotmatrix.h 
-
 SOURCES = \
-    plotmatrix.cpp \
     main.cpp
@@ -16,6 +16,162 @@
 #include <qpalette.h>
 #include <qmap.h>
 #include <qlocale.h>
+#include <qcache.h>
+#include <qmutex.h>
+#include <qthread.h>
+#include <qapplication.h>
+#include <qdesktopwidget.h>
+#if QT_VERSION >= 0x040700
+#include <qstatictext.h>
+#endif
+
+namespace
+{
+    class TickLabel
+    {
+    public:
+        TickLabel()
+#if QT_VERSION >= 0x040700
+            : hasStaticText( false )
+#endif
+        {
+        }
+
+        // label with an initialized layout cache
+        QwtText text;
+
+#if QT_VERSION >= 0x040700
+        // pre shaped plain text, positioned like QwtText::draw() does
+        bool hasStaticText;
+        QFont font;
+        QPointF position;
+        QStaticText staticText;
+#endif
+    };
+
+    /*
+      Labels, that have been measured for one scale draw, are likely
+      to appear on other scales ( f.e. the same range on many plots )
+      or on the same scale after the next replot. So measured labels
+      are kept in a bounded LRU cache, that is shared by all scale draws.
+     */
+    class TickLabelCache
+    {
+    public:
+        TickLabelCache():
+            d_cache( 2000 )
+        {
+        }
+
+        bool find( const QString &key, const QwtText &text, TickLabel &label )
+        {
+            QMutexLocker locker( &d_mutex );
+
+            const TickLabel *cached = d_cache.object( key );
+            if ( cached == NULL || cached->text != text )
+                return false;
+
+            label = *cached;
+            return true;
+        }
+
+        void insert( const QString &key, const TickLabel &label )
+        {
+            QMutexLocker locker( &d_mutex );
+            d_cache.insert( key, new TickLabel( label ) );
+        }
+
+    private:
+        QMutex d_mutex;
+        QCache<QString, TickLabel> d_cache;
+    };
+}
+
+Q_GLOBAL_STATIC( TickLabelCache, qwtTickLabelCache )
+
+static inline bool qwtIsGuiThread()
+{
+    const QCoreApplication *app = QCoreApplication::instance();
+    return app && QThread::currentThread() == app->thread();
+}
+
+static TickLabel qwtCreateTickLabel( const QFont &font,
+    const QwtText &text, bool withStaticText )
+{
+    TickLabel label;
+    label.text = text;
+
+    ( void )label.text.textSize( font ); // initialize the internal cache
+
+#if QT_VERSION >= 0x040700
+    QwtText plainText( text.text(), QwtText::PlainText );
+    plainText.setRenderFlags( text.renderFlags() );
+
+    if ( withStaticText && text == plainText
+        && !text.text().contains( QLatin1Char( '\n' ) ) )
+    {
+        // plain text without any decorations
+
+        // static texts are prepared for the screen only
+        const QFont metricsFont( font, QApplication::desktop() );
+
+        double left, right, top, bottom;
+        QwtText::textEngine( QwtText::PlainText )->textMargins(
+            metricsFont, text.text(), left, right, top, bottom );
+
+        label.hasStaticText = true;
+        label.font = font;
+        label.position = QPointF( -left, -top );
+
+        label.staticText.setText( text.text() );
+        label.staticText.setTextFormat( Qt::PlainText );
+        label.staticText.setPerformanceHint( QStaticText::AggressiveCaching );
+        label.staticText.prepare( QTransform(), font );
+    }
+#else
+    Q_UNUSED( withStaticText );
+#endif
+
+    return label;
+}
+
+#if QT_VERSION >= 0x040700
+
+static inline bool qwtCanDrawStatic( QPainter *painter )
+{
+    // QStaticText shares its layout between copies and updates
+    // it lazily, what is not safe when painting in other threads.
+    // For vector formats we want to have regular text.
+
+    if ( !qwtIsGuiThread() )
+        return false;
+
+    if ( !QwtPainter::isAligning( painter ) )
+        return false;
+
+    if ( painter->font().pixelSize() < 0 )
+    {
+        // QwtPainter::drawText() unscales the font for devices
+        // with a different resolution
+
+        const QPaintDevice *metricsDevice = QwtPainter::metricsDevice();
+        if ( metricsDevice == NULL )
+            metricsDevice = QApplication::desktop();
+
+        const QPaintDevice *pd = painter->device();
+
+        if ( metricsDevice == NULL || pd == NULL
+            || pd->logicalDpiX() != metricsDevice->logicalDpiX()
+            || pd->logicalDpiY() != metricsDevice->logicalDpiY() )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif
 
 class QwtAbstractScaleDraw::PrivateData
 {
@@ -45,7 +201,7 @@ public:
 
     double minExtent;
 
-    QMap<double, QwtText> labelCache;
+    QMap<double, TickLabel> labelCache;
 };
 
 /*!
@@ -384,27 +540,95 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
    calculation of the label sizes might be slow (really slow
    for rich text in Qt4), so it's necessary to cache the labels.
 
+   Beside the cache of each scale draw, the measured labels
+   are stored in a limited cache, that is shared between all
+   scale draws. So labels don't need to be measured again, when
+   they appear on another scale or after the scale division has
+   been changed. The lookup is done by text and font and the cached
+   label is only used, when it is equal to the one returned by label().
+   The shared cache is used in the GUI thread only.
+
    \param font Font
    \param value Value
 
    \return Tick label
+   \sa drawTickLabel()
 */
 const QwtText &QwtAbstractScaleDraw::tickLabel(
     const QFont &font, double value ) const
 {
-    QMap<double, QwtText>::const_iterator it = d_data->labelCache.find( value );
+    QMap<double, TickLabel>::const_iterator it =
+        d_data->labelCache.find( value );
+
     if ( it == d_data->labelCache.end() )
     {
         QwtText lbl = label( value );
         lbl.setRenderFlags( 0 );
         lbl.setLayoutAttribute( QwtText::MinimumLayout );
 
-        ( void )lbl.textSize( font ); // initialize the internal cache
+        QString key = font.key();
+        key += QLatin1Char( '|' );
+        key += lbl.text();
+
+        /*
+            The screen font and the static text are resolved in the
+            GUI thread only. Labels for other threads or for
+            other metrics devices ( see QwtPainter::metricsDevice() )
+            are neither shared nor prepared as static text.
+         */
+        const bool isScreen = qwtIsGuiThread()
+            && QwtPainter::metricsDevice() == NULL;
 
-        it = d_data->labelCache.insert( value, lbl );
+        TickLabelCache *sharedCache =
+            isScreen ? qwtTickLabelCache() : NULL;
+
+        TickLabel cachedLabel;
+        if ( sharedCache == NULL || !sharedCache->find( key, lbl, cachedLabel ) )
+        {
+            cachedLabel = qwtCreateTickLabel( font, lbl, isScreen );
+            if ( sharedCache )
+                sharedCache->insert( key, cachedLabel );
+        }
+
+        it = d_data->labelCache.insert( value, cachedLabel );
+    }
+
+    return it->text;
+}
+
+/*!
+   \brief Draw the label for a value into a rectangle
+
+   Plain text labels without any decorations are drawn using
+   a QStaticText, that has been prepared, when the label has been
+   cached. This is done for painting on screen only - in all other
+   situations, f.e. when exporting to PDF, or when painting
+   in a thread different from the GUI thread - the result
+   of tickLabel() is painted using QwtText::draw().
+
+   \param painter Painter
+   \param value Value
+   \param rect Rectangle of the size of the label
+
+   \sa tickLabel(), drawLabel()
+*/
+void QwtAbstractScaleDraw::drawTickLabel( QPainter *painter,
+    double value, const QRectF &rect ) const
+{
+    const QwtText &lbl = tickLabel( painter->font(), value );
+
+#if QT_VERSION >= 0x040700
+    const TickLabel &cachedLabel = d_data->labelCache[ value ];
+    if ( cachedLabel.hasStaticText && cachedLabel.font == painter->font()
+        && qwtCanDrawStatic( painter ) )
+    {
+        painter->drawStaticText( rect.topLeft() + cachedLabel.position,
+            cachedLabel.staticText );
+        return;
     }
+#endif
 
-    return ( *it );
+    lbl.draw( painter, rect );
 }
 
 /*!
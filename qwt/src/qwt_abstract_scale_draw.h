@@ -17,6 +17,7 @@
 class QPalette;
 class QPainter;
 class QFont;
+class QRectF;
 class QwtTransform;
 class QwtScaleMap;
 
@@ -128,6 +129,7 @@ protected:
     virtual void drawLabel( QPainter *painter, double value ) const = 0;
 
     const QwtText &tickLabel( const QFont &, double value ) const;
+    void drawTickLabel( QPainter *, double value, const QRectF & ) const;
 
 private:
     Q_DISABLE_COPY(QwtAbstractScaleDraw)
@@ -10,6 +10,7 @@
 #include "qwt_color_map.h"
 #include "qwt_math.h"
 #include "qwt_interval.h"
+#include <qnumeric.h>
 
 #if (__GNUC__ * 100 + __GNUC_MINOR__) >= 408
 
@@ -323,6 +324,31 @@ uint QwtColorMap::colorIndex( int numColors,
 #pragma GCC pop_options
 #endif
 
+/*!
+  \brief Map a row of values into RGB values
+
+  The default implementation calls rgb() for each value, but
+  color maps might reimplement it to avoid the overhead of
+  a virtual call per value.
+
+  \param interval Range for all values
+  \param values Array of values
+  \param numValues Number of values
+  \param rgbs Array of at least numValues, where to store the RGB values
+
+  \note NaN values are mapped to 0u ( transparent ).
+  \sa rgb(), QwtPlotSpectrogram::renderTile()
+*/
+void QwtColorMap::rgbRow( const QwtInterval &interval,
+    const double *values, int numValues, QRgb *rgbs ) const
+{
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+        rgbs[i] = qIsNaN( value ) ? 0u : rgb( interval, value );
+    }
+}
+
 /*!
    Build and return a color map of 256 colors
 
@@ -368,8 +394,52 @@ QVector<QRgb> QwtColorMap::colorTable( int numColors ) const
 class QwtLinearColorMap::PrivateData
 {
 public:
+    PrivateData():
+        mode( ScaledColors ),
+        lookupTableSize( 0 )
+    {
+    }
+
+    void updateLookupTable()
+    {
+        if ( lookupTableSize <= 0 )
+        {
+            lookupTable.clear();
+            return;
+        }
+
+        lookupTable.resize( lookupTableSize );
+
+        const double step = 1.0 / ( lookupTableSize - 1 );
+        for ( int i = 0; i < lookupTableSize; i++ )
+            lookupTable[i] = colorStops.rgb( mode, i * step );
+    }
+
+    inline QRgb lookup( double ratio ) const
+    {
+        // undefined values are displayed as in rgbRow()
+        if ( qIsNaN( ratio ) )
+            return 0u;
+
+        const int maxIndex = lookupTable.size() - 1;
+
+        if ( ratio <= 0.0 )
+            return lookupTable[0];
+
+        if ( ratio >= 1.0 )
+            return lookupTable[maxIndex];
+
+        const double v = ratio * maxIndex;
+        const int index = ( mode == FixedColors ) ? int( v ) : int( v + 0.5 );
+
+        return lookupTable[index];
+    }
+
     ColorStops colorStops;
     QwtLinearColorMap::Mode mode;
+
+    int lookupTableSize;
+    QVector<QRgb> lookupTable;
 };
 
 /*!
@@ -382,8 +452,6 @@ QwtLinearColorMap::QwtLinearColorMap( QwtColorMap::Format format ):
     QwtColorMap( format )
 {
     d_data = new PrivateData;
-    d_data->mode = ScaledColors;
-
     setColorInterval( Qt::blue, Qt::yellow );
 }
 
@@ -399,7 +467,6 @@ QwtLinearColorMap::QwtLinearColorMap( const QColor &color1,
     QwtColorMap( format )
 {
     d_data = new PrivateData;
-    d_data->mode = ScaledColors;
     setColorInterval( color1, color2 );
 }
 
@@ -420,7 +487,11 @@ QwtLinearColorMap::~QwtLinearColorMap()
 */
 void QwtLinearColorMap::setMode( Mode mode )
 {
-    d_data->mode = mode;
+    if ( mode != d_data->mode )
+    {
+        d_data->mode = mode;
+        d_data->updateLookupTable();
+    }
 }
 
 /*!
@@ -448,6 +519,8 @@ void QwtLinearColorMap::setColorInterval(
     d_data->colorStops = ColorStops();
     d_data->colorStops.insert( 0.0, color1 );
     d_data->colorStops.insert( 1.0, color2 );
+
+    d_data->updateLookupTable();
 }
 
 /*!
@@ -463,7 +536,10 @@ void QwtLinearColorMap::setColorInterval(
 void QwtLinearColorMap::addColorStop( double value, const QColor& color )
 {
     if ( value >= 0.0 && value <= 1.0 )
+    {
         d_data->colorStops.insert( value, color );
+        d_data->updateLookupTable();
+    }
 }
 
 /*!
@@ -492,6 +568,45 @@ QColor QwtLinearColorMap::color2() const
     return QColor( d_data->colorStops.rgb( d_data->mode, 1.0 ) );
 }
 
+/*!
+  \brief Enable a precalculated lookup table
+
+  Mapping a value into a color needs a binary search for the
+  adjacent color stops and - in ScaledColors mode - an interpolation 
+  between them. When a lookup table is enabled the colors are
+  calculated in advance for size equidistant positions in [0.0, 1.0]
+  and rgb() is reduced to an index calculation.
+
+  The table is rebuilt whenever the color stops or the mode change.
+  A size of 4096 is usually precise enough to be visually
+  indistinguishable from the exact calculation.
+
+  \param size Number of entries of the table. A value < 2 disables
+              the lookup table, what is the default setting.
+
+  \sa lookupTableSize(), rgb(), rgbRow()
+*/
+void QwtLinearColorMap::setLookupTableSize( int size )
+{
+    if ( size < 2 )
+        size = 0;
+
+    if ( size != d_data->lookupTableSize )
+    {
+        d_data->lookupTableSize = size;
+        d_data->updateLookupTable();
+    }
+}
+
+/*!
+  \return Size of the lookup table, 0 when disabled
+  \sa setLookupTableSize()
+*/
+int QwtLinearColorMap::lookupTableSize() const
+{
+    return d_data->lookupTableSize;
+}
+
 /*!
   Map a value of a given interval into a RGB value
 
@@ -499,6 +614,7 @@ QColor QwtLinearColorMap::color2() const
   \param value Value to map into a RGB value
 
   \return RGB value for value
+  \sa setLookupTableSize()
 */
 QRgb QwtLinearColorMap::rgb(
     const QwtInterval &interval, double value ) const
@@ -508,9 +624,80 @@ QRgb QwtLinearColorMap::rgb(
         return 0u;
 
     const double ratio = ( value - interval.minValue() ) / width;
+
+    if ( d_data->lookupTableSize > 0 )
+        return d_data->lookup( ratio );
+
     return d_data->colorStops.rgb( d_data->mode, ratio );
 }
 
+/*!
+  \brief Map a row of values into RGB values
+
+  \param interval Range for all values
+  \param values Array of values
+  \param numValues Number of values
+  \param rgbs Array of at least numValues, where to store the RGB values
+
+  \note NaN values are mapped to 0u ( transparent ).
+  \sa rgb(), setLookupTableSize()
+*/
+void QwtLinearColorMap::rgbRow( const QwtInterval &interval,
+    const double *values, int numValues, QRgb *rgbs ) const
+{
+    const double width = interval.width();
+    if ( width <= 0.0 )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            rgbs[i] = 0u;
+
+        return;
+    }
+
+    const double min = interval.minValue();
+
+    if ( d_data->lookupTableSize > 0 )
+    {
+        // no binary search, no interpolation: a multiplication
+        // and a table lookup per value
+        const QRgb *table = d_data->lookupTable.constData();
+        const int maxIndex = d_data->lookupTable.size() - 1;
+
+        const double factor = maxIndex / width;
+        const double offset = ( d_data->mode == FixedColors ) ? 0.0 : 0.5;
+
+        for ( int i = 0; i < numValues; i++ )
+        {
+            const double value = values[i];
+            if ( qIsNaN( value ) )
+            {
+                rgbs[i] = 0u;
+            }
+            else
+            {
+                double v = ( value - min ) * factor + offset;
+                v = qBound( 0.0, v, double( maxIndex ) );
+
+                rgbs[i] = table[ int( v ) ];
+            }
+        }
+    }
+    else
+    {
+        const ColorStops &colorStops = d_data->colorStops;
+        const Mode mode = d_data->mode;
+
+        for ( int i = 0; i < numValues; i++ )
+        {
+            const double value = values[i];
+            if ( qIsNaN( value ) )
+                rgbs[i] = 0u;
+            else
+                rgbs[i] = colorStops.rgb( mode, ( value - min ) / width );
+        }
+    }
+}
+
 #ifdef QWT_GCC_OPTIMIZE
 #pragma GCC push_options
 #pragma GCC optimize("tree-partial-pre")
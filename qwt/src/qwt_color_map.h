@@ -75,6 +75,9 @@ public:
     virtual uint colorIndex( int numColors,
         const QwtInterval &interval, double value ) const;
 
+    virtual void rgbRow( const QwtInterval &interval,
+        const double *values, int numValues, QRgb *rgbs ) const;
+
     QColor color( const QwtInterval &, double value ) const;
     virtual QVector<QRgb> colorTable( int numColors ) const;
     virtual QVector<QRgb> colorTable256() const;
@@ -124,10 +127,16 @@ public:
     QColor color1() const;
     QColor color2() const;
 
+    void setLookupTableSize( int size );
+    int lookupTableSize() const;
+
     virtual QRgb rgb( const QwtInterval &, double value ) const;
     virtual uint colorIndex( int numColors,
         const QwtInterval &, double value ) const;
 
+    virtual void rgbRow( const QwtInterval &,
+        const double *values, int numValues, QRgb *rgbs ) const;
+
     class ColorStops;
 
 private:
@@ -291,3 +291,83 @@ void QwtColumnSymbol::drawBox( QPainter *painter,
         }
     }
 }
+
+/*!
+  Constructor
+  \param orientation Orientation of the columns
+ */
+QwtColumnMerger::QwtColumnMerger( Qt::Orientation orientation ):
+    d_orientation( orientation ),
+    d_pixel( 0 )
+{
+}
+
+/*!
+  \brief Merge a column
+
+  \param column Column in paint device coordinates
+  \return true, when the column has been merged. Columns, that are
+          not narrower than a pixel are not merged and need to be
+          painted individually.
+ */
+bool QwtColumnMerger::append( const QwtColumnRect &column )
+{
+    const QwtInterval hIntv = column.hInterval.normalized();
+    const QwtInterval vIntv = column.vInterval.normalized();
+
+    const QwtInterval &intv =
+        ( d_orientation == Qt::Vertical ) ? hIntv : vIntv;
+
+    if ( intv.width() >= 1.0 )
+        return false;
+
+    const int pixel = qFloor( 0.5 * ( intv.minValue() + intv.maxValue() ) );
+
+    if ( !d_rects.isEmpty() && pixel == d_pixel )
+    {
+        QRectF &r = d_rects.last();
+
+        r.setLeft( qMin( r.left(), hIntv.minValue() ) );
+        r.setRight( qMax( r.right(), hIntv.maxValue() ) );
+        r.setTop( qMin( r.top(), vIntv.minValue() ) );
+        r.setBottom( qMax( r.bottom(), vIntv.maxValue() ) );
+    }
+    else
+    {
+        d_rects += QRectF( hIntv.minValue(), vIntv.minValue(),
+            hIntv.width(), vIntv.width() );
+
+        d_pixel = pixel;
+    }
+
+    return true;
+}
+
+/*!
+  \brief Draw the merged columns
+
+  The rectangles are painted with the pen and brush of the painter.
+
+  \param painter Painter
+ */
+void QwtColumnMerger::draw( QPainter *painter )
+{
+    if ( d_rects.isEmpty() )
+        return;
+
+    if ( QwtPainter::roundingAlignment( painter ) )
+    {
+        for ( int i = 0; i < d_rects.size(); i++ )
+        {
+            QRectF &r = d_rects[i];
+
+            r.setLeft( qRound( r.left() ) );
+            r.setRight( qRound( r.right() ) );
+            r.setTop( qRound( r.top() ) );
+            r.setBottom( qRound( r.bottom() ) );
+        }
+    }
+
+    QwtPainter::drawRects( painter,
+        d_rects.constData(), d_rects.size() );
+}
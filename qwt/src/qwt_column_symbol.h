@@ -15,6 +15,7 @@
 #include <qpen.h>
 #include <qsize.h>
 #include <qrect.h>
+#include <qvector.h>
 
 class QPainter;
 class QPalette;
@@ -89,6 +90,31 @@ public:
     Direction direction;
 };
 
+/*!
+  \brief Merges columns, that are narrower than a pixel
+
+  Columns, that are narrower than a pixel and have their center
+  in the same pixel, are united into one rectangle. This reduces
+  the number of painted rectangles for histograms or bar charts
+  with many samples.
+
+  \sa QwtPlotHistogram::MergeColumns, QwtPlotBarChart::MergeBars
+*/
+class QWT_EXPORT QwtColumnMerger
+{
+public:
+    explicit QwtColumnMerger( Qt::Orientation );
+
+    bool append( const QwtColumnRect & );
+    void draw( QPainter * );
+
+private:
+    const Qt::Orientation d_orientation;
+    int d_pixel;
+
+    QVector<QRectF> d_rects;
+};
+
 //! A drawing primitive for columns
 class QWT_EXPORT QwtColumnSymbol
 {
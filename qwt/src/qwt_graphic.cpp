@@ -9,6 +9,7 @@
 
 #include "qwt_graphic.h"
 #include "qwt_painter_command.h"
+#include "qwt_painter.h"
 #include <qvector.h>
 #include <qpainter.h>
 #include <qpaintengine.h>
@@ -16,6 +17,8 @@
 #include <qpixmap.h>
 #include <qpainterpath.h>
 #include <qmath.h>
+#include <qmutex.h>
+#include <qlist.h>
 
 static bool qwtHasScalablePen( const QPainter *painter )
 {
@@ -37,6 +40,21 @@ static bool qwtHasScalablePen( const QPainter *painter )
     return scalablePen;
 }
 
+static inline bool qwtCanUseRasterCache( const QPainter *painter )
+{
+    // for vector devices the commands need to be replayed
+
+    if ( painter->paintEngine()->type() != QPaintEngine::Raster )
+        return false;
+
+    // the image is aligned to the pixel grid
+
+    if ( painter->transform().type() > QTransform::TxTranslate )
+        return false;
+
+    return painter->compositionMode() == QPainter::CompositionMode_SourceOver;
+}
+
 static QRectF qwtStrokedPathRect( 
     const QPainter *painter, const QPainterPath &path )
 {
@@ -200,11 +218,369 @@ static inline void qwtExecCommand(
 
 }
 
+static void qwtRenderCommands( QPainter *painter,
+    const QVector<QwtPainterCommand> &commands,
+    QwtGraphic::RenderHints renderHints,
+    const QTransform *initialTransform )
+{
+    const int numCommands = commands.size();
+    const QwtPainterCommand *cmds = commands.constData();
+
+    const QTransform transform = painter->transform();
+
+    painter->save();
+
+    for ( int i = 0; i < numCommands; i++ )
+    {
+        qwtExecCommand( painter, cmds[i],
+            renderHints, transform, initialTransform );
+    }
+
+    painter->restore();
+}
+
+static inline QPaintEngine::DirtyFlags qwtClipFlags()
+{
+    return QPaintEngine::DirtyClipEnabled
+        | QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath;
+}
+
+static inline bool qwtIsOpaque( const QBrush &brush )
+{
+    return ( brush.style() == Qt::SolidPattern )
+        && ( brush.color().alpha() == 255 );
+}
+
+namespace
+{
+    /*
+      The painter state, that results from replaying the state commands.
+      As a graphic inherits the state of the painter, where it is
+      replayed, only properties, that have been set, are known.
+     */
+    class PaintState
+    {
+    public:
+        PaintState():
+            knownFlags( 0 ),
+            backgroundMode( Qt::TransparentMode ),
+            compositionMode( QPainter::CompositionMode_SourceOver ),
+            opacity( 1.0 )
+        {
+        }
+
+        // removes all flags of properties, whose values don't change
+
+        void reduce( QwtPainterCommand::StateData *data ) const
+        {
+            const QPaintEngine::DirtyFlags flags = data->flags & knownFlags;
+
+            if ( ( flags & QPaintEngine::DirtyPen ) && data->pen == pen )
+                data->flags &= ~QPaintEngine::DirtyPen;
+
+            if ( ( flags & QPaintEngine::DirtyBrush ) && data->brush == brush )
+                data->flags &= ~QPaintEngine::DirtyBrush;
+
+            if ( ( flags & QPaintEngine::DirtyBrushOrigin )
+                && data->brushOrigin == brushOrigin )
+            {
+                data->flags &= ~QPaintEngine::DirtyBrushOrigin;
+            }
+
+            if ( ( flags & QPaintEngine::DirtyFont ) && data->font == font )
+                data->flags &= ~QPaintEngine::DirtyFont;
+
+            if ( ( flags & QPaintEngine::DirtyBackground )
+                && data->backgroundMode == backgroundMode
+                && data->backgroundBrush == backgroundBrush )
+            {
+                data->flags &= ~QPaintEngine::DirtyBackground;
+            }
+
+            if ( ( flags & QPaintEngine::DirtyTransform )
+                && data->transform == transform )
+            {
+                data->flags &= ~QPaintEngine::DirtyTransform;
+            }
+
+            if ( ( flags & QPaintEngine::DirtyHints )
+                && data->renderHints == renderHints )
+            {
+                data->flags &= ~QPaintEngine::DirtyHints;
+            }
+
+            if ( ( flags & QPaintEngine::DirtyCompositionMode )
+                && data->compositionMode == compositionMode )
+            {
+                data->flags &= ~QPaintEngine::DirtyCompositionMode;
+            }
+
+            if ( ( flags & QPaintEngine::DirtyOpacity )
+                && data->opacity == opacity )
+            {
+                data->flags &= ~QPaintEngine::DirtyOpacity;
+            }
+        }
+
+        void apply( const QwtPainterCommand::StateData *data )
+        {
+            if ( data->flags & QPaintEngine::DirtyPen )
+                pen = data->pen;
+
+            if ( data->flags & QPaintEngine::DirtyBrush )
+                brush = data->brush;
+
+            if ( data->flags & QPaintEngine::DirtyBrushOrigin )
+                brushOrigin = data->brushOrigin;
+
+            if ( data->flags & QPaintEngine::DirtyFont )
+                font = data->font;
+
+            if ( data->flags & QPaintEngine::DirtyBackground )
+            {
+                backgroundMode = data->backgroundMode;
+                backgroundBrush = data->backgroundBrush;
+            }
+
+            if ( data->flags & QPaintEngine::DirtyTransform )
+                transform = data->transform;
+
+            if ( data->flags & QPaintEngine::DirtyHints )
+                renderHints = data->renderHints;
+
+            if ( data->flags & QPaintEngine::DirtyCompositionMode )
+                compositionMode = data->compositionMode;
+
+            if ( data->flags & QPaintEngine::DirtyOpacity )
+                opacity = data->opacity;
+
+            knownFlags |= data->flags & ~qwtClipFlags();
+        }
+
+        // consecutive paths can be merged, when the result is the same
+
+        bool canMergePaths( const QRectF &rect1, const QRectF &rect2 ) const
+        {
+            const QPaintEngine::DirtyFlags flags =
+                QPaintEngine::DirtyPen | QPaintEngine::DirtyBrush;
+
+            if ( ( knownFlags & flags ) != flags )
+                return false;
+
+            if ( ( knownFlags & QPaintEngine::DirtyOpacity )
+                && opacity != 1.0 )
+            {
+                return false;
+            }
+
+            if ( ( knownFlags & QPaintEngine::DirtyCompositionMode )
+                && compositionMode != QPainter::CompositionMode_SourceOver )
+            {
+                return false;
+            }
+
+            // overlapping parts would be painted only once
+
+            const bool hasPen = pen.style() != Qt::NoPen;
+            if ( hasPen )
+            {
+                if ( pen.style() != Qt::SolidLine || !qwtIsOpaque( pen.brush() ) )
+                    return false;
+
+                // strokes might overlap, what makes no difference
+                // only, when they are known to be painted opaque
+
+                const QPaintEngine::DirtyFlags opaqueFlags =
+                    QPaintEngine::DirtyOpacity | QPaintEngine::DirtyCompositionMode;
+
+                if ( ( knownFlags & opaqueFlags ) != opaqueFlags )
+                    return false;
+            }
+
+            if ( brush.style() != Qt::NoBrush )
+            {
+                // the fills of overlapping paths would depend on the fill
+                // rule and the outline of one path would be painted on top
+                // of the fill of the other
+
+                if ( hasPen || !qwtIsOpaque( brush ) || rect1.intersects( rect2 ) )
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        QPaintEngine::DirtyFlags knownFlags;
+
+        QPen pen;
+        QBrush brush;
+        QPointF brushOrigin;
+        QFont font;
+        Qt::BGMode backgroundMode;
+        QBrush backgroundBrush;
+        QTransform transform;
+        QPainter::RenderHints renderHints;
+        QPainter::CompositionMode compositionMode;
+        qreal opacity;
+    };
+}
+
+static inline QPaintEngine::DirtyFlags qwtReplayedFlags()
+{
+    // the flags, that are evaluated by qwtExecCommand
+
+    return QPaintEngine::DirtyPen | QPaintEngine::DirtyBrush
+        | QPaintEngine::DirtyBrushOrigin | QPaintEngine::DirtyFont
+        | QPaintEngine::DirtyBackground | QPaintEngine::DirtyTransform
+        | QPaintEngine::DirtyClipEnabled | QPaintEngine::DirtyClipRegion
+        | QPaintEngine::DirtyClipPath | QPaintEngine::DirtyHints
+        | QPaintEngine::DirtyCompositionMode | QPaintEngine::DirtyOpacity;
+}
+
+static bool qwtMergeStates( QwtPainterCommand::StateData *data,
+    const QwtPainterCommand::StateData *other )
+{
+    // qwtExecCommand applies the clip after the transformation,
+    // so the order of clip and transformation changes would be lost
+
+    if ( ( data->flags & qwtClipFlags() ) || ( other->flags & qwtClipFlags() ) )
+        return false;
+
+    const QPaintEngine::DirtyFlags flags = other->flags;
+
+    if ( flags & QPaintEngine::DirtyPen )
+        data->pen = other->pen;
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        data->brush = other->brush;
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        data->brushOrigin = other->brushOrigin;
+
+    if ( flags & QPaintEngine::DirtyFont )
+        data->font = other->font;
+
+    if ( flags & QPaintEngine::DirtyBackground )
+    {
+        data->backgroundMode = other->backgroundMode;
+        data->backgroundBrush = other->backgroundBrush;
+    }
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        data->transform = other->transform;
+
+    if ( flags & QPaintEngine::DirtyHints )
+        data->renderHints = other->renderHints;
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+        data->compositionMode = other->compositionMode;
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+        data->opacity = other->opacity;
+
+    data->flags |= flags;
+
+    return true;
+}
+
+static void qwtCompactCommands( QVector<QwtPainterCommand> &commands )
+{
+    const int numCommands = commands.size();
+    const QwtPainterCommand *cmds = commands.constData();
+
+    QVector<QwtPainterCommand> compacted;
+    compacted.reserve( numCommands );
+
+    PaintState state;
+
+    // control point rectangle of the last path, when there
+    // are no other commands behind it
+    QRectF pathRect;
+    bool isPathOpen = false;
+
+    for ( int i = 0; i < numCommands; i++ )
+    {
+        const QwtPainterCommand &cmd = cmds[i];
+
+        switch( cmd.type() )
+        {
+            case QwtPainterCommand::State:
+            {
+                QwtPainterCommand stateCmd = cmd;
+                QwtPainterCommand::StateData *data = stateCmd.stateData();
+
+                state.reduce( data );
+                if ( ( data->flags & qwtReplayedFlags() ) == 0 )
+                {
+                    // nothing changes
+                    break;
+                }
+
+                state.apply( data );
+
+                bool merged = false;
+                if ( !compacted.isEmpty()
+                    && compacted.last().type() == QwtPainterCommand::State )
+                {
+                    merged = qwtMergeStates(
+                        compacted.last().stateData(), data );
+                }
+
+                if ( !merged )
+                    compacted += stateCmd;
+
+                isPathOpen = false;
+                break;
+            }
+            case QwtPainterCommand::Path:
+            {
+                const QPainterPath *path = cmd.path();
+                const QRectF rect = path->controlPointRect();
+
+                bool merged = false;
+                if ( isPathOpen && state.canMergePaths( pathRect, rect ) )
+                {
+                    QPainterPath *openPath = compacted.last().path();
+                    if ( openPath->fillRule() == path->fillRule() )
+                    {
+                        openPath->addPath( *path );
+                        pathRect |= rect;
+
+                        merged = true;
+                    }
+                }
+
+                if ( !merged )
+                {
+                    compacted += cmd;
+
+                    pathRect = rect;
+                    isPathOpen = true;
+                }
+
+                break;
+            }
+            default:
+            {
+                compacted += cmd;
+                isPathOpen = false;
+            }
+        }
+    }
+
+    commands = compacted;
+}
+
 class QwtGraphic::PathInfo
 {
 public:
     PathInfo():
-        d_scalablePen( false )
+        d_scalablePen( false ),
+        d_left( 0.0 ),
+        d_right( 0.0 ),
+        d_top( 0.0 ),
+        d_bottom( 0.0 )
     {
         // QVector needs a default constructor
     }
@@ -215,6 +591,13 @@ public:
         d_boundingRect( boundingRect ),
         d_scalablePen( scalablePen )
     {
+        // the extents of the outline are needed for each
+        // scaling calculation, so we calculate them once
+
+        d_left = qAbs( pointRect.left() - boundingRect.left() );
+        d_right = qAbs( pointRect.right() - boundingRect.right() );
+        d_top = qAbs( pointRect.top() - boundingRect.top() );
+        d_bottom = qAbs( pointRect.bottom() - boundingRect.bottom() );
     }
 
     inline QRectF scaledBoundingRect( double sx, double sy,
@@ -234,13 +617,7 @@ public:
         else
         {
             rect = transform.mapRect( d_pointRect );
-
-            const double l = qAbs( d_pointRect.left() - d_boundingRect.left() );
-            const double r = qAbs( d_pointRect.right() - d_boundingRect.right() );
-            const double t = qAbs( d_pointRect.top() - d_boundingRect.top() );
-            const double b = qAbs( d_pointRect.bottom() - d_boundingRect.bottom() );
-
-            rect.adjust( -l, -t, r, b );
+            rect.adjust( -d_left, -d_top, d_right, d_bottom );
         }
 
         return rect;
@@ -267,10 +644,7 @@ public:
         }
         else
         {
-            const double pw = qMax( 
-                qAbs( d_boundingRect.left() - d_pointRect.left() ),
-                qAbs( d_boundingRect.right() - d_pointRect.right() ) );
-
+            const double pw = qMax( d_left, d_right );
             sx = ( w - 2 * pw ) / d_pointRect.width();
         }
 
@@ -298,10 +672,7 @@ public:
         }
         else
         {
-            const double pw = 
-                qMax( qAbs( d_boundingRect.top() - d_pointRect.top() ),
-                qAbs( d_boundingRect.bottom() - d_pointRect.bottom() ) );
-
+            const double pw = qMax( d_top, d_bottom );
             sy = ( h - 2 * pw ) / d_pointRect.height();
         }
 
@@ -312,15 +683,151 @@ private:
     QRectF d_pointRect;
     QRectF d_boundingRect;
     bool d_scalablePen;
+
+    double d_left;
+    double d_right;
+    double d_top;
+    double d_bottom;
 };
 
+namespace
+{
+    class RasterCache
+    {
+    public:
+        class Key
+        {
+        public:
+            inline bool operator==( const Key &other ) const
+            {
+                return ( size == other.size )
+                    && ( pixelRatio == other.pixelRatio )
+                    && ( renderHints == other.renderHints )
+                    && ( aspectRatioMode == other.aspectRatioMode );
+            }
+
+            QSizeF size;
+            qreal pixelRatio;
+            QPainter::RenderHints renderHints;
+            Qt::AspectRatioMode aspectRatioMode;
+        };
+
+        RasterCache():
+            maxSize( 0 )
+        {
+        }
+
+        RasterCache( const RasterCache &other )
+        {
+            QMutexLocker locker( &other.mutex );
+
+            maxSize = other.maxSize;
+            entries = other.entries;
+        }
+
+        RasterCache &operator=( const RasterCache &other )
+        {
+            if ( &other != this )
+            {
+                QList<Entry> otherEntries;
+                int otherMaxSize;
+
+                {
+                    QMutexLocker locker( &other.mutex );
+
+                    otherEntries = other.entries;
+                    otherMaxSize = other.maxSize;
+                }
+
+                QMutexLocker locker( &mutex );
+
+                entries = otherEntries;
+                maxSize = otherMaxSize;
+            }
+
+            return *this;
+        }
+
+        void setMaxSize( int size )
+        {
+            QMutexLocker locker( &mutex );
+
+            maxSize = qMax( size, 0 );
+            while ( entries.size() > maxSize )
+                entries.removeLast();
+        }
+
+        int capacity() const
+        {
+            QMutexLocker locker( &mutex );
+            return maxSize;
+        }
+
+        void clear()
+        {
+            QMutexLocker locker( &mutex );
+            entries.clear();
+        }
+
+        QImage find( const Key &key )
+        {
+            QMutexLocker locker( &mutex );
+
+            for ( int i = 0; i < entries.size(); i++ )
+            {
+                if ( entries[i].key == key )
+                {
+                    // the most recently used entry is the first one
+
+                    if ( i > 0 )
+                        entries.move( i, 0 );
+
+                    return entries.first().image;
+                }
+            }
+
+            return QImage();
+        }
+
+        void insert( const Key &key, const QImage &image )
+        {
+            QMutexLocker locker( &mutex );
+
+            if ( maxSize <= 0 )
+                return;
+
+            while ( entries.size() >= maxSize )
+                entries.removeLast();
+
+            Entry entry;
+            entry.key = key;
+            entry.image = image;
+
+            entries.prepend( entry );
+        }
+
+    private:
+        class Entry
+        {
+        public:
+            Key key;
+            QImage image;
+        };
+
+        int maxSize;
+        QList<Entry> entries;
+
+        // render() might be called from different threads
+        mutable QMutex mutex;
+    };
+}
+
 class QwtGraphic::PrivateData
 {
 public:
     PrivateData():
         boundingRect( 0.0, 0.0, -1.0, -1.0 ),
-        pointRect( 0.0, 0.0, -1.0, -1.0 ),
-        initialTransform( NULL )
+        pointRect( 0.0, 0.0, -1.0, -1.0 )
     {
     }
 
@@ -332,7 +839,8 @@ public:
     QRectF pointRect;
 
     QwtGraphic::RenderHints renderHints;
-    QTransform *initialTransform;
+
+    RasterCache rasterCache;
 };
 
 /*!
@@ -394,6 +902,7 @@ void QwtGraphic::reset()
     d_data->pointRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
     d_data->defaultSize = QSizeF();
 
+    d_data->rasterCache.clear();
 }
 
 /*!
@@ -428,6 +937,8 @@ void QwtGraphic::setRenderHint( RenderHint hint, bool on )
         d_data->renderHints |= hint;
     else
         d_data->renderHints &= ~hint;
+
+    d_data->rasterCache.clear();
 }
 
 /*!
@@ -442,6 +953,39 @@ bool QwtGraphic::testRenderHint( RenderHint hint ) const
     return d_data->renderHints.testFlag( hint );
 }
 
+/*!
+  \brief Set the size of the raster cache
+
+  When rendering the graphic to a raster device ( QImage, QPixmap,
+  widgets ) with a painter, that is not scaled or rotated, the
+  graphic is rendered into an image, that is stored in a cache. When
+  the graphic is rendered again with the same target size, device pixel
+  ratio, render hints and aspect ratio mode the image is painted instead
+  of replaying the commands. When the cache is full the least recently
+  used image is removed.
+
+  The position of the image is aligned to the pixel grid. Vector
+  devices ( PDF, SVG, QwtGraphic ... ) always replay the commands.
+
+  The default setting is 0, what disables the cache.
+
+  \param numImages Maximum number of cached images
+  \sa rasterCacheSize(), render()
+ */
+void QwtGraphic::setRasterCacheSize( int numImages )
+{
+    d_data->rasterCache.setMaxSize( numImages );
+}
+
+/*!
+  \return Maximum number of cached images
+  \sa setRasterCacheSize()
+ */
+int QwtGraphic::rasterCacheSize() const
+{
+    return d_data->rasterCache.capacity();
+}
+
 /*!
   The bounding rectangle is the controlPointRect()
   extended by the areas needed for rendering the outlines
@@ -565,20 +1109,8 @@ void QwtGraphic::render( QPainter *painter ) const
     if ( isNull() )
         return;
 
-    const int numCommands = d_data->commands.size();
-    const QwtPainterCommand *commands = d_data->commands.constData();
-
-    const QTransform transform = painter->transform();
-
-    painter->save();
-
-    for ( int i = 0; i < numCommands; i++ )
-    {
-        qwtExecCommand( painter, commands[i], 
-            d_data->renderHints, transform, d_data->initialTransform );
-    }
-
-    painter->restore();
+    qwtRenderCommands( painter, d_data->commands,
+        d_data->renderHints, NULL );
 }
 
 /*!
@@ -606,6 +1138,8 @@ void QwtGraphic::render( QPainter *painter, const QSizeF &size,
   \param painter Qt painter
   \param rect Rectangle for the scaled graphic
   \param aspectRatioMode Mode how to scale - See Qt::AspectRatioMode
+
+  \sa setRasterCacheSize()
  */
 void QwtGraphic::render( QPainter *painter, const QRectF &rect, 
     Qt::AspectRatioMode aspectRatioMode ) const
@@ -613,6 +1147,60 @@ void QwtGraphic::render( QPainter *painter, const QRectF &rect,
     if ( isEmpty() || rect.isEmpty() )
         return;
 
+    if ( d_data->rasterCache.capacity() > 0 && qwtCanUseRasterCache( painter ) )
+        renderCached( painter, rect, aspectRatioMode );
+    else
+        renderScaled( painter, rect, aspectRatioMode );
+}
+
+void QwtGraphic::renderCached( QPainter *painter, const QRectF &rect,
+    Qt::AspectRatioMode aspectRatioMode ) const
+{
+    // a margin for antialiased edges, that exceed the rectangle
+    const int margin = 1;
+
+    RasterCache::Key key;
+    key.size = rect.size();
+    key.pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+    key.renderHints = painter->renderHints();
+    key.aspectRatioMode = aspectRatioMode;
+
+    QImage image = d_data->rasterCache.find( key );
+    if ( image.isNull() )
+    {
+        const QSize size(
+            qCeil( ( rect.width() + 2 * margin ) * key.pixelRatio ),
+            qCeil( ( rect.height() + 2 * margin ) * key.pixelRatio ) );
+
+        image = QImage( size, QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+        image.setDevicePixelRatio( key.pixelRatio );
+#endif
+        image.fill( 0 );
+
+        QPainter imagePainter( &image );
+        imagePainter.setRenderHints( key.renderHints );
+
+        renderScaled( &imagePainter,
+            QRectF( QPointF( margin, margin ), rect.size() ), aspectRatioMode );
+
+        imagePainter.end();
+
+        d_data->rasterCache.insert( key, image );
+    }
+
+    const QPointF pos = painter->transform().map( rect.topLeft() );
+
+    painter->save();
+    painter->resetTransform();
+    painter->drawImage(
+        QPointF( qRound( pos.x() ) - margin, qRound( pos.y() ) - margin ), image );
+    painter->restore();
+}
+
+void QwtGraphic::renderScaled( QPainter *painter, const QRectF &rect,
+    Qt::AspectRatioMode aspectRatioMode ) const
+{
     double sx = 1.0; 
     double sy = 1.0;
 
@@ -662,23 +1250,33 @@ void QwtGraphic::render( QPainter *painter, const QRectF &rect,
     tr.translate( -d_data->pointRect.x(), -d_data->pointRect.y() );
 
     const QTransform transform = painter->transform();
-    if ( !scalePens && transform.isScaling() )
+
+    /*
+        The initial transformation is passed as local, instead of
+        storing it in the graphic, as render() might be called
+        from different threads.
+     */
+    QTransform initialTransform;
+    const bool hasInitialTransform = !scalePens && transform.isScaling();
+
+    if ( hasInitialTransform )
     {
         // we don't want to scale pens according to sx/sy,
-        // but we want to apply the scaling from the 
+        // but we want to apply the scaling from the
         // painter transformation later
 
-        d_data->initialTransform = new QTransform();
-        d_data->initialTransform->scale( transform.m11(), transform.m22() );
+        initialTransform.scale( transform.m11(), transform.m22() );
     }
 
     painter->setTransform( tr, true );
-    render( painter );
 
-    painter->setTransform( transform );
+    if ( !isNull() )
+    {
+        qwtRenderCommands( painter, d_data->commands, d_data->renderHints,
+            hasInitialTransform ? &initialTransform : NULL );
+    }
 
-    delete d_data->initialTransform;
-    d_data->initialTransform = NULL;
+    painter->setTransform( transform );
 }
 
 /*!
@@ -864,24 +1462,50 @@ void QwtGraphic::drawPath( const QPainterPath &path )
     if ( painter == NULL )
         return;
 
-    d_data->commands += QwtPainterCommand( path );
+    d_data->rasterCache.clear();
 
-    if ( !path.isEmpty() )
+    if ( path.isEmpty() )
     {
-        const QPainterPath scaledPath = painter->transform().map( path );
+        d_data->commands += QwtPainterCommand( path );
+        return;
+    }
 
-        QRectF pointRect = scaledPath.boundingRect();
-        QRectF boundingRect = pointRect;
+    const QPainterPath scaledPath = painter->transform().map( path );
 
-        if ( painter->pen().style() != Qt::NoPen 
-            && painter->pen().brush().style() != Qt::NoBrush )
-        {
-            boundingRect = qwtStrokedPathRect( painter, path );
-        }
+    QRectF pointRect = scaledPath.boundingRect();
+    QRectF boundingRect = pointRect;
+
+    if ( painter->pen().style() != Qt::NoPen
+        && painter->pen().brush().style() != Qt::NoBrush )
+    {
+        boundingRect = qwtStrokedPathRect( painter, path );
+    }
 
-        updateControlPointRect( pointRect );
-        updateBoundingRect( boundingRect );
+    bool isVisible = true;
+    if ( painter->hasClipping() )
+    {
+        QRectF cr = painter->clipRegion().boundingRect();
+        cr = painter->transform().mapRect( cr );
+
+        // the clip region is rounded to integers
+        cr.adjust( -1.0, -1.0, 1.0, 1.0 );
+
+        isVisible = boundingRect.intersects( cr );
+    }
+
+    if ( isVisible )
+        d_data->commands += QwtPainterCommand( path );
+
+    updateControlPointRect( pointRect );
+    updateBoundingRect( boundingRect );
 
+    if ( boundingRect != pointRect )
+    {
+        /*
+          Paths without an outline never limit the scale factors
+          in render() and never extend scaledBoundingRect(),
+          as they are inside of the control point rectangle.
+         */
         d_data->pathInfos += PathInfo( pointRect, 
             boundingRect, qwtHasScalablePen( painter ) );
     }
@@ -903,6 +1527,8 @@ void QwtGraphic::drawPixmap( const QRectF &rect,
     if ( painter == NULL )
         return;
 
+    d_data->rasterCache.clear();
+
     d_data->commands += QwtPainterCommand( rect, pixmap, subRect );
 
     const QRectF r = painter->transform().mapRect( rect );
@@ -927,6 +1553,8 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
     if ( painter == NULL )
         return;
 
+    d_data->rasterCache.clear();
+
     d_data->commands += QwtPainterCommand( rect, image, subRect, flags );
 
     const QRectF r = painter->transform().mapRect( rect );
@@ -943,9 +1571,28 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
  */
 void QwtGraphic::updateState( const QPaintEngineState &state)
 {
+    d_data->rasterCache.clear();
     d_data->commands += QwtPainterCommand( state );
 }
 
+/*!
+  \brief Compact the command list, when the painter has finished recording
+
+  State changes without effect are removed and consecutive state changes
+  are merged. Consecutive paths with the same fill rule are merged,
+  when they are painted with an opaque pen without brush, or with an
+  opaque brush without pen and don't overlap. Stroked paths are merged
+  only, when the opacity of the painter is known to be 1.0 and its
+  composition mode is known to be QPainter::CompositionMode_SourceOver.
+
+  \sa commands()
+ */
+void QwtGraphic::endPaint()
+{
+    qwtCompactCommands( d_data->commands );
+    d_data->rasterCache.clear();
+}
+
 void QwtGraphic::updateBoundingRect( const QRectF &rect )
 {
     QRectF br = rect;
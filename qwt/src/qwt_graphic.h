@@ -69,6 +69,17 @@ class QwtPainterCommand;
     scaling with a fixed aspect ratio always needs to be calculated from the 
     control point rectangle.
 
+    When a painter has finished recording, the command list is compacted:
+    state changes without effect are removed, consecutive state changes
+    are merged, and consecutive paths are merged into one path, when
+    this doesn't change the result. Paths, that are completely
+    clipped, are not recorded at all.
+
+    Graphics, that are used as icons or symbols, are often rendered many times
+    in the same size. For raster devices the graphic can keep a small
+    cache of images ( see setRasterCacheSize() ), so that the commands
+    have to be replayed only once for each size.
+
     \sa QwtPainterCommand
  */
 class QWT_EXPORT QwtGraphic: public QwtNullPaintDevice
@@ -147,6 +158,9 @@ public:
     void setRenderHint( RenderHint, bool on = true );
     bool testRenderHint( RenderHint ) const;
 
+    void setRasterCacheSize( int numImages );
+    int rasterCacheSize() const;
+
 protected:
     virtual QSize sizeMetrics() const;
 
@@ -160,7 +174,12 @@ protected:
 
     virtual void updateState( const QPaintEngineState &state );
 
+    virtual void endPaint();
+
 private:
+    void renderScaled( QPainter *, const QRectF &, Qt::AspectRatioMode ) const;
+    void renderCached( QPainter *, const QRectF &, Qt::AspectRatioMode ) const;
+
     void updateBoundingRect( const QRectF & );
     void updateControlPointRect( const QRectF & );
 
@@ -0,0 +1,827 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_histogram_data.h"
+#include "qwt_math.h"
+#include <qnumeric.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+#include <string.h>
+
+// the minimum number of values, that is worth to start a thread
+static const size_t qwtMinValuesPerThread = 50000;
+
+// the resolution of the histogram, that is used for adaptive bins
+static const int qwtAdaptiveResolution = 16;
+
+/*
+  Helper class to work around the 5 parameters
+  limitation of QtConcurrent::run()
+ */
+class QwtHistogramBinning
+{
+public:
+    QwtHistogramBinning():
+        isLogarithmic( false ),
+        min( 0.0 ),
+        max( 0.0 ),
+        numBins( 0 )
+    {
+    }
+
+    inline bool isValid() const
+    {
+        return numBins > 0 && max > min;
+    }
+
+    // lower border of a bin in value coordinates
+    inline double edge( int index ) const
+    {
+        const double v = min + index * ( max - min ) / numBins;
+        return isLogarithmic ? ::exp( v ) : v;
+    }
+
+    bool isLogarithmic;
+
+    // bounds in binning coordinates: log( value ) for isLogarithmic
+    double min;
+    double max;
+
+    int numBins;
+};
+
+static QVector<quint64> qwtCountValues( const QwtHistogramBinning binning,
+    const double *values, size_t from, size_t to )
+{
+    QVector<quint64> counts( binning.numBins, 0 );
+    quint64 *c = counts.data();
+
+    const double factor = binning.numBins / ( binning.max - binning.min );
+
+    for ( size_t i = from; i < to; i++ )
+    {
+        double v = values[i];
+        if ( binning.isLogarithmic )
+        {
+            if ( !( v > 0.0 ) )
+                continue;
+
+            v = ::log( v );
+        }
+
+        if ( !qIsFinite( v ) )
+            continue;
+
+        if ( !( v >= binning.min && v <= binning.max ) )
+            continue;
+
+        int index = static_cast<int>( ( v - binning.min ) * factor );
+        if ( index >= binning.numBins )
+            index = binning.numBins - 1;
+
+        c[index]++;
+    }
+
+    return counts;
+}
+
+static QwtInterval qwtValueRange( bool positiveOnly,
+    const double *values, size_t from, size_t to )
+{
+    double min = 0.0;
+    double max = -1.0;
+
+    for ( size_t i = from; i < to; i++ )
+    {
+        const double v = values[i];
+
+        if ( !qIsFinite( v ) || ( positiveOnly && !( v > 0.0 ) ) )
+            continue;
+
+        if ( min > max )
+        {
+            min = max = v;
+        }
+        else
+        {
+            if ( v < min )
+                min = v;
+            else if ( v > max )
+                max = v;
+        }
+    }
+
+    return QwtInterval( min, max );
+}
+
+static inline uint qwtThreadCount( uint numThreads, size_t numValues )
+{
+#if !defined(QT_NO_QFUTURE)
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    const size_t maxThreads = numValues / qwtMinValuesPerThread + 1;
+    if ( numThreads > maxThreads )
+        numThreads = static_cast<uint>( maxThreads );
+
+    if ( numThreads <= 0 )
+        numThreads = 1;
+
+    return numThreads;
+#else
+    Q_UNUSED( numThreads )
+    Q_UNUSED( numValues )
+    return 1;
+#endif
+}
+
+static QVector<quint64> qwtCountValuesParallel(
+    const QwtHistogramBinning &binning, uint numThreads,
+    const double *values, size_t from, size_t to )
+{
+    numThreads = qwtThreadCount( numThreads, to - from );
+
+#if !defined(QT_NO_QFUTURE)
+    if ( numThreads > 1 )
+    {
+        // each thread builds a partial histogram
+
+        const size_t chunkSize = ( to - from ) / numThreads;
+
+        QList< QFuture< QVector<quint64> > > futures;
+        for ( uint i = 0; i < numThreads - 1; i++ )
+        {
+            const size_t start = from + i * chunkSize;
+
+            futures += QtConcurrent::run( &qwtCountValues,
+                binning, values, start, start + chunkSize );
+        }
+
+        QVector<quint64> counts = qwtCountValues( binning, values,
+            from + ( numThreads - 1 ) * chunkSize, to );
+
+        quint64 *c = counts.data();
+        for ( int i = 0; i < futures.size(); i++ )
+        {
+            const QVector<quint64> partialCounts = futures[i].result();
+            for ( int j = 0; j < partialCounts.size(); j++ )
+                c[j] += partialCounts[j];
+        }
+
+        return counts;
+    }
+#endif
+
+    return qwtCountValues( binning, values, from, to );
+}
+
+static QwtInterval qwtValueRangeParallel( bool positiveOnly,
+    uint numThreads, const double *values, size_t from, size_t to )
+{
+    numThreads = qwtThreadCount( numThreads, to - from );
+
+#if !defined(QT_NO_QFUTURE)
+    if ( numThreads > 1 )
+    {
+        const size_t chunkSize = ( to - from ) / numThreads;
+
+        QList< QFuture<QwtInterval> > futures;
+        for ( uint i = 0; i < numThreads - 1; i++ )
+        {
+            const size_t start = from + i * chunkSize;
+
+            futures += QtConcurrent::run( &qwtValueRange,
+                positiveOnly, values, start, start + chunkSize );
+        }
+
+        QwtInterval range = qwtValueRange( positiveOnly, values,
+            from + ( numThreads - 1 ) * chunkSize, to );
+
+        for ( int i = 0; i < futures.size(); i++ )
+            range |= futures[i].result();
+
+        return range;
+    }
+#endif
+
+    return qwtValueRange( positiveOnly, values, from, to );
+}
+
+class QwtHistogramData::PrivateData
+{
+public:
+    PrivateData():
+        rawValues( NULL ),
+        numRawValues( 0 ),
+        binningMode( QwtHistogramData::FixedBins ),
+        numBins( 100 ),
+        numThreads( 0 ),
+        numBinnedValues( 0 ),
+        isDataRange( false ),
+        numRangeValues( 0 ),
+        isPositiveRange( false )
+    {
+    }
+
+    inline const double *valueArray() const
+    {
+        return rawValues ? rawValues : values.constData();
+    }
+
+    inline size_t valueCount() const
+    {
+        return rawValues ? numRawValues : size_t( values.size() );
+    }
+
+    void updateValueRange()
+    {
+        const size_t numValues = valueCount();
+
+        const bool positiveOnly =
+            ( binningMode == QwtHistogramData::LogarithmicBins );
+
+        if ( numRangeValues > numValues || positiveOnly != isPositiveRange )
+        {
+            valueRange = QwtInterval();
+            numRangeValues = 0;
+        }
+
+        if ( numRangeValues < numValues )
+        {
+            // only the values, that have not been included before
+
+            valueRange |= qwtValueRangeParallel( positiveOnly,
+                numThreads, valueArray(), numRangeValues, numValues );
+
+            numRangeValues = numValues;
+            isPositiveRange = positiveOnly;
+        }
+    }
+
+    QVector<double> values;
+
+    const double *rawValues;
+    size_t numRawValues;
+
+    QwtHistogramData::BinningMode binningMode;
+    int numBins;
+    uint numThreads;
+
+    QwtInterval interval;
+    QRectF rectOfInterest;
+    QwtInterval intervalOfInterest;
+
+    // the current bins
+    QwtHistogramBinning binning;
+    QVector<double> edges;
+    QVector<quint64> counts;
+
+    size_t numBinnedValues;
+
+    // the range has been calculated from the values
+    bool isDataRange;
+    QwtInterval dataRange;
+
+    // the range of all values - regardless of the bins
+    QwtInterval valueRange;
+    size_t numRangeValues;
+    bool isPositiveRange;
+
+    QVector<QwtIntervalSample> samples;
+};
+
+/*!
+  \brief Constructor
+
+  \param numBins Number of bins
+  \sa setNumBins(), setValues(), setRawValues()
+ */
+QwtHistogramData::QwtHistogramData( int numBins )
+{
+    d_data = new PrivateData;
+    d_data->numBins = qMax( numBins, 1 );
+}
+
+//! Destructor
+QwtHistogramData::~QwtHistogramData()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Assign the values to be counted
+
+  The values are copied and the bins are recalculated.
+
+  \param values Values
+  \sa appendValues(), setRawValues()
+ */
+void QwtHistogramData::setValues( const QVector<double> &values )
+{
+    d_data->rawValues = NULL;
+    d_data->numRawValues = 0;
+
+    d_data->values = values;
+    d_data->numRangeValues = 0;
+
+    rebin();
+}
+
+/*!
+  \brief Append values
+
+  The values are counted into the existing bins, when they
+  don't need to be recalculated.
+
+  \param values Values to be appended
+  \note When raw values have been assigned, they are copied
+        before appending the values.
+
+  \sa setValues(), setRawValues()
+ */
+void QwtHistogramData::appendValues( const QVector<double> &values )
+{
+    if ( values.isEmpty() )
+        return;
+
+    if ( d_data->rawValues )
+    {
+        const double *rawValues = d_data->rawValues;
+        const size_t numRawValues = d_data->numRawValues;
+
+        d_data->rawValues = NULL;
+        d_data->numRawValues = 0;
+
+        d_data->values.resize( static_cast<int>( numRawValues ) );
+        ::memcpy( d_data->values.data(), rawValues,
+            numRawValues * sizeof( double ) );
+    }
+
+    d_data->values += values;
+
+    binAppended();
+}
+
+/*!
+  \brief Assign an array of values, without copying them
+
+  The values might be stored in memory, that is mapped from a file.
+  When the same array is passed with a larger numValues, only
+  the appended values are counted, if possible. This assumes,
+  that the values, that have been passed before, are unchanged.
+  When the same array is passed with the same numValues, all
+  values are counted again.
+
+  \param values Array of values
+  \param numValues Number of values
+
+  \warning The array needs to be valid as long as it is
+           assigned to the histogram data.
+  \sa setValues(), appendValues()
+ */
+void QwtHistogramData::setRawValues( const double *values, size_t numValues )
+{
+    // passing the same array again without new values
+    // indicates, that the values have been modified
+
+    const bool isAppending = ( values != NULL )
+        && ( values == d_data->rawValues )
+        && ( numValues > d_data->numBinnedValues );
+
+    d_data->values.clear();
+    d_data->rawValues = values;
+    d_data->numRawValues = values ? numValues : 0;
+
+    if ( isAppending )
+    {
+        binAppended();
+    }
+    else
+    {
+        d_data->numRangeValues = 0;
+        rebin();
+    }
+}
+
+/*!
+  \return Array of the values
+  \sa numValues(), setValues(), setRawValues()
+ */
+const double *QwtHistogramData::values() const
+{
+    return d_data->valueArray();
+}
+
+/*!
+  \return Number of values
+  \sa values(), setValues(), setRawValues()
+ */
+size_t QwtHistogramData::numValues() const
+{
+    return d_data->valueCount();
+}
+
+/*!
+  \brief Set the mode how to calculate the bins
+
+  \param mode Binning mode
+  \sa binningMode()
+ */
+void QwtHistogramData::setBinningMode( BinningMode mode )
+{
+    if ( mode != d_data->binningMode )
+    {
+        d_data->binningMode = mode;
+        rebin();
+    }
+}
+
+/*!
+  \return Mode how to calculate the bins
+  \sa setBinningMode()
+ */
+QwtHistogramData::BinningMode QwtHistogramData::binningMode() const
+{
+    return d_data->binningMode;
+}
+
+/*!
+  \brief Set the number of bins
+
+  \param numBins Number of bins
+  \sa numBins()
+ */
+void QwtHistogramData::setNumBins( int numBins )
+{
+    numBins = qMax( numBins, 1 );
+    if ( numBins != d_data->numBins )
+    {
+        d_data->numBins = numBins;
+        rebin();
+    }
+}
+
+/*!
+  \return Number of bins
+  \sa setNumBins()
+ */
+int QwtHistogramData::numBins() const
+{
+    return d_data->numBins;
+}
+
+/*!
+  \brief Set a fixed interval for the bins
+
+  When the interval is valid, the bins are calculated for it,
+  regardless of the rectangle of interest or the range of the values.
+  Values outside of the interval are not counted.
+
+  \param interval Interval
+  \sa interval(), setRectOfInterest()
+ */
+void QwtHistogramData::setInterval( const QwtInterval &interval )
+{
+    const QwtInterval intv = interval.normalized();
+    if ( intv != d_data->interval )
+    {
+        d_data->interval = intv;
+        rebin();
+    }
+}
+
+/*!
+  \return Fixed interval for the bins
+  \sa setInterval()
+ */
+QwtInterval QwtHistogramData::interval() const
+{
+    return d_data->interval;
+}
+
+/*!
+  \brief Set the number of threads for counting the values
+
+  \param numThreads Number of threads. When numThreads is set to 0,
+                    the system specific ideal thread count is used.
+
+  \note Threads are not started for less than 50000 values.
+  \sa numThreads()
+ */
+void QwtHistogramData::setNumThreads( uint numThreads )
+{
+    d_data->numThreads = numThreads;
+}
+
+/*!
+  \return Number of threads for counting the values
+  \sa setNumThreads()
+ */
+uint QwtHistogramData::numThreads() const
+{
+    return d_data->numThreads;
+}
+
+//! \return Number of bins, that have been calculated
+size_t QwtHistogramData::size() const
+{
+    return d_data->samples.size();
+}
+
+/*!
+  \param i Index
+  \return Bin at position i
+ */
+QwtIntervalSample QwtHistogramData::sample( size_t i ) const
+{
+    return d_data->samples[ static_cast<int>( i ) ];
+}
+
+//! \return Bins, that have been calculated
+QVector<QwtIntervalSample> QwtHistogramData::samples() const
+{
+    return d_data->samples;
+}
+
+/*!
+  \brief Bounding rectangle of the bins and the values
+
+  The x coordinates include the range of all finite values - also of
+  those outside of the bins. So autoscaling follows the values, even
+  when the bins are calculated for the rectangle of interest only.
+
+  \return Bounding rectangle
+ */
+QRectF QwtHistogramData::boundingRect() const
+{
+    if ( d_boundingRect.width() < 0 )
+    {
+        d_boundingRect = qwtBoundingRect( *this );
+
+        const QwtInterval &range = d_data->valueRange;
+        if ( range.isValid() )
+        {
+            if ( d_boundingRect.width() < 0 )
+            {
+                d_boundingRect = QRectF( range.minValue(), 0.0,
+                    range.width(), 0.0 );
+            }
+            else
+            {
+                d_boundingRect.setLeft(
+                    qMin( d_boundingRect.left(), range.minValue() ) );
+                d_boundingRect.setRight(
+                    qMax( d_boundingRect.right(), range.maxValue() ) );
+            }
+        }
+    }
+
+    return d_boundingRect;
+}
+
+/*!
+   Set a the "rectangle of interest"
+
+   QwtPlotSeriesItem defines the current area of the plot canvas
+   as "rect of interest" ( QwtPlotSeriesItem::updateScaleDiv() ).
+
+   If interval().isValid() == false the bins are recalculated
+   for the interval rect.left() -> rect.right(), whenever it changes.
+   Values outside of it are not counted, but are included
+   in boundingRect().
+
+   \param rect Rectangle of interest
+   \sa rectOfInterest(), setInterval()
+*/
+void QwtHistogramData::setRectOfInterest( const QRectF &rect )
+{
+    d_data->rectOfInterest = rect;
+
+    const QwtInterval intv = QwtInterval(
+        rect.left(), rect.right() ).normalized();
+
+    if ( intv != d_data->intervalOfInterest )
+    {
+        d_data->intervalOfInterest = intv;
+
+        if ( !d_data->interval.isValid() )
+            rebin();
+    }
+}
+
+/*!
+   \return "rectangle of interest"
+   \sa setRectOfInterest()
+*/
+QRectF QwtHistogramData::rectOfInterest() const
+{
+    return d_data->rectOfInterest;
+}
+
+void QwtHistogramData::rebin()
+{
+    d_data->binning = QwtHistogramBinning();
+    d_data->edges.clear();
+    d_data->counts.clear();
+    d_data->numBinnedValues = 0;
+    d_data->isDataRange = false;
+    d_data->dataRange = QwtInterval();
+
+    const double *values = d_data->valueArray();
+    const size_t numValues = d_data->valueCount();
+
+    const bool isLogarithmic =
+        ( d_data->binningMode == QwtHistogramData::LogarithmicBins );
+
+    d_data->updateValueRange();
+
+    QwtInterval range = d_data->interval;
+    if ( !range.isValid() && d_data->intervalOfInterest.width() > 0.0 )
+        range = d_data->intervalOfInterest;
+
+    if ( !range.isValid() && numValues > 0 )
+    {
+        range = d_data->valueRange;
+
+        d_data->isDataRange = true;
+        d_data->dataRange = range;
+    }
+
+    if ( isLogarithmic && range.isValid() && range.minValue() <= 0.0
+        && range.maxValue() > 0.0 && !d_data->isDataRange )
+    {
+        /*
+          An interval, that includes values <= 0.0 is clipped to
+          the smallest positive value. As the lower bound depends
+          on the values now, appended values might need a rebin.
+         */
+        const QwtInterval &positiveRange = d_data->valueRange;
+
+        if ( positiveRange.isValid()
+            && positiveRange.minValue() < range.maxValue() )
+        {
+            range.setMinValue( positiveRange.minValue() );
+
+            // only the lower bound depends on the values
+            d_data->isDataRange = true;
+            d_data->dataRange = QwtInterval( range.minValue(), qInf() );
+        }
+    }
+
+    if ( !range.isValid() || ( isLogarithmic && range.minValue() <= 0.0 )
+        || !qIsFinite( range.minValue() ) || !qIsFinite( range.maxValue() ) )
+    {
+        updateSamples();
+        return;
+    }
+
+    if ( range.width() <= 0.0 )
+    {
+        // all values are the same
+        const double off = isLogarithmic ? 0.5 * range.minValue() : 0.5;
+        range = QwtInterval( range.minValue() - off, range.maxValue() + off );
+    }
+
+    QwtHistogramBinning binning;
+    binning.isLogarithmic = isLogarithmic;
+    binning.min = isLogarithmic ? ::log( range.minValue() ) : range.minValue();
+    binning.max = isLogarithmic ? ::log( range.maxValue() ) : range.maxValue();
+    binning.numBins = d_data->numBins;
+
+    if ( d_data->binningMode == QwtHistogramData::AdaptiveBins )
+    {
+        /*
+          We count the values in a histogram with a higher resolution
+          and merge its bins, so that each bin has about
+          the same number of values.
+         */
+
+        QwtHistogramBinning fineBinning = binning;
+        fineBinning.numBins *= qwtAdaptiveResolution;
+
+        const QVector<quint64> fineCounts = qwtCountValuesParallel(
+            fineBinning, d_data->numThreads, values, 0, numValues );
+
+        quint64 total = 0;
+        for ( int i = 0; i < fineCounts.size(); i++ )
+            total += fineCounts[i];
+
+        const double target = double( total ) / d_data->numBins;
+
+        d_data->edges += fineBinning.edge( 0 );
+
+        quint64 sum = 0;
+        quint64 count = 0;
+
+        for ( int i = 0; i < fineCounts.size(); i++ )
+        {
+            sum += fineCounts[i];
+            count += fineCounts[i];
+
+            const bool isLast = ( i == fineCounts.size() - 1 );
+
+            if ( isLast || ( d_data->counts.size() < d_data->numBins - 1
+                && sum >= ( d_data->counts.size() + 1 ) * target ) )
+            {
+                d_data->edges += isLast ? range.maxValue() : fineBinning.edge( i + 1 );
+                d_data->counts += count;
+
+                count = 0;
+            }
+        }
+    }
+    else
+    {
+        d_data->counts = qwtCountValuesParallel(
+            binning, d_data->numThreads, values, 0, numValues );
+
+        for ( int i = 0; i < binning.numBins; i++ )
+            d_data->edges += binning.edge( i );
+
+        d_data->edges += range.maxValue();
+    }
+
+    d_data->binning = binning;
+    d_data->numBinnedValues = numValues;
+
+    updateSamples();
+}
+
+void QwtHistogramData::binAppended()
+{
+    const double *values = d_data->valueArray();
+    const size_t numValues = d_data->valueCount();
+
+    const size_t from = d_data->numBinnedValues;
+    if ( from == numValues )
+        return;
+
+    d_data->updateValueRange();
+
+    if ( d_data->binningMode == QwtHistogramData::AdaptiveBins
+        || !d_data->binning.isValid() || from > numValues )
+    {
+        rebin();
+        return;
+    }
+
+    if ( d_data->isDataRange )
+    {
+        const QwtInterval &range = d_data->valueRange;
+
+        if ( range.isValid() && ( range.minValue() < d_data->dataRange.minValue()
+            || range.maxValue() > d_data->dataRange.maxValue() ) )
+        {
+            // the new values don't fit into the bins
+            rebin();
+            return;
+        }
+    }
+
+    const QVector<quint64> counts = qwtCountValuesParallel(
+        d_data->binning, d_data->numThreads, values, from, numValues );
+
+    quint64 *c = d_data->counts.data();
+    for ( int i = 0; i < counts.size(); i++ )
+        c[i] += counts[i];
+
+    d_data->numBinnedValues = numValues;
+
+    updateSamples();
+}
+
+void QwtHistogramData::updateSamples()
+{
+    d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    const int numBins = d_data->counts.size();
+
+    d_data->samples.resize( numBins );
+    QwtIntervalSample *samples = d_data->samples.data();
+
+    const bool isDensity =
+        ( d_data->binningMode == QwtHistogramData::AdaptiveBins );
+
+    for ( int i = 0; i < numBins; i++ )
+    {
+        const double x1 = d_data->edges[i];
+        const double x2 = d_data->edges[i + 1];
+
+        double value = d_data->counts[i];
+        if ( isDensity )
+            value = ( x2 > x1 ) ? value / ( x2 - x1 ) : 0.0;
+
+        QwtInterval interval( x1, x2 );
+        if ( i < numBins - 1 )
+            interval.setBorderFlags( QwtInterval::ExcludeMaximum );
+
+        samples[i] = QwtIntervalSample( value, interval );
+    }
+}
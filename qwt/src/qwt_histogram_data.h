@@ -0,0 +1,122 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_HISTOGRAM_DATA_H
+#define QWT_HISTOGRAM_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_interval.h"
+#include <qvector.h>
+
+/*!
+  \brief Series of histogram bins, that are calculated from raw values
+
+  QwtHistogramData counts raw values into bins and offers them
+  as QwtIntervalSample series, that can be displayed by QwtPlotHistogram.
+  The values are counted in parallel by numThreads() threads, each of
+  them building a partial histogram for a chunk of the values.
+
+  The bins are calculated for:
+
+  - interval(), when it is valid
+  - the x interval of the rectangle of interest, when it is valid.
+    So the bins are recalculated for the visible area, when
+    zooming or panning.
+  - the range of the values otherwise
+
+  The values can be appended with appendValues() or by passing
+  the same array of raw values with an increased size to setRawValues().
+  The new values are counted into the existing bins, unless the bins
+  have to be recalculated because of an extended range or AdaptiveBins.
+
+  \code
+    QwtHistogramData *data = new QwtHistogramData( 400 );
+    data->setRawValues( values, numValues );
+
+    QwtPlotHistogram *histogram = new QwtPlotHistogram();
+    histogram->setData( data );
+  \endcode
+
+  \note The number of bins is not adjusted to the size of the canvas.
+        For a histogram, that matches the resolution of the screen,
+        it needs to be updated, when the plot gets resized.
+*/
+class QWT_EXPORT QwtHistogramData: public QwtSeriesData<QwtIntervalSample>
+{
+public:
+    /*!
+      \brief Calculation of the bins
+      \sa setBinningMode()
+     */
+    enum BinningMode
+    {
+        //! Bins of the same width, the value of a bin is its count
+        FixedBins,
+
+        /*!
+          Bins of the same width on a logarithmic scale, the value of
+          a bin is its count. Values <= 0 are ignored. An interval
+          or rectangle of interest, that includes values <= 0,
+          is clipped to the smallest positive value.
+         */
+        LogarithmicBins,
+
+        /*!
+          Bins with ( approximately ) the same number of values.
+          As the counts are similar the value of a bin is the density:
+          its count divided by its width.
+         */
+        AdaptiveBins
+    };
+
+    explicit QwtHistogramData( int numBins = 100 );
+    virtual ~QwtHistogramData();
+
+    void setValues( const QVector<double> & );
+    void appendValues( const QVector<double> & );
+
+    void setRawValues( const double *values, size_t numValues );
+
+    const double *values() const;
+    size_t numValues() const;
+
+    void setBinningMode( BinningMode );
+    BinningMode binningMode() const;
+
+    void setNumBins( int );
+    int numBins() const;
+
+    void setInterval( const QwtInterval & );
+    QwtInterval interval() const;
+
+    void setNumThreads( uint );
+    uint numThreads() const;
+
+    virtual size_t size() const;
+    virtual QwtIntervalSample sample( size_t i ) const;
+    virtual QRectF boundingRect() const;
+
+    virtual void setRectOfInterest( const QRectF & );
+    QRectF rectOfInterest() const;
+
+    QVector<QwtIntervalSample> samples() const;
+
+private:
+    Q_DISABLE_COPY(QwtHistogramData)
+
+    void rebin();
+    void binAppended();
+    void updateSamples();
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
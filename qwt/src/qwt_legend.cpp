@@ -13,12 +13,14 @@
 #include "qwt_math.h"
 #include "qwt_plot_item.h"
 #include "qwt_painter.h"
+#include "qwt_legend_hash_p.h"
 #include <qapplication.h>
 #include <qscrollbar.h>
 #include <qscrollarea.h>
 #include <qpainter.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
+#include <qhash.h>
 
 class QwtLegendMap
 {
@@ -35,9 +37,10 @@ public:
 
 private:
     // we don't know anything about itemInfo and therefore don't have
-    // any key that can be used for a map or hashtab.
-    // But a simple linear list is o.k. here, as we will never have
-    // more than a few entries.
+    // a key, that can be used for a hashtab. But in almost all cases
+    // itemInfo is a plot item ( QwtPlot::itemToInfo() ), so we use the
+    // address of the item - or the string representation for other
+    // types - as hash value and compare the entries with the same value.
 
     class Entry
     {
@@ -46,63 +49,96 @@ private:
         QList<QWidget *> widgets;
     };
 
-    QList< Entry > d_entries;
+    typedef QMultiHash<uint, Entry> EntryHash;
+
+    EntryHash::iterator findEntry( const QVariant & );
+    EntryHash::const_iterator findEntry( const QVariant & ) const;
+
+    EntryHash d_entries;
+    QHash<const QWidget *, QVariant> d_widgetMap;
 };
 
+QwtLegendMap::EntryHash::iterator QwtLegendMap::findEntry(
+    const QVariant &itemInfo )
+{
+    const uint key = qwtItemHash( itemInfo );
+
+    for ( EntryHash::iterator it = d_entries.find( key );
+        it != d_entries.end() && it.key() == key; ++it )
+    {
+        if ( it.value().itemInfo == itemInfo )
+            return it;
+    }
+
+    return d_entries.end();
+}
+
+QwtLegendMap::EntryHash::const_iterator QwtLegendMap::findEntry(
+    const QVariant &itemInfo ) const
+{
+    const uint key = qwtItemHash( itemInfo );
+
+    for ( EntryHash::const_iterator it = d_entries.find( key );
+        it != d_entries.end() && it.key() == key; ++it )
+    {
+        if ( it.value().itemInfo == itemInfo )
+            return it;
+    }
+
+    return d_entries.end();
+}
+
 void QwtLegendMap::insert( const QVariant &itemInfo, 
     const QList<QWidget *> &widgets )
 {
-    for ( int i = 0; i < d_entries.size(); i++ )
+    EntryHash::iterator it = findEntry( itemInfo );
+    if ( it == d_entries.end() )
     {
-        Entry &entry = d_entries[i];
-        if ( entry.itemInfo == itemInfo )
-        {
-            entry.widgets = widgets;
-            return;
-        }
+        Entry newEntry;
+        newEntry.itemInfo = itemInfo;
+
+        it = d_entries.insert( qwtItemHash( itemInfo ), newEntry );
     }
 
-    Entry newEntry;
-    newEntry.itemInfo = itemInfo;
-    newEntry.widgets = widgets;
+    Entry &entry = it.value();
+
+    for ( int i = 0; i < entry.widgets.size(); i++ )
+        d_widgetMap.remove( entry.widgets[i] );
+
+    entry.widgets = widgets;
 
-    d_entries += newEntry;
+    for ( int i = 0; i < widgets.size(); i++ )
+        d_widgetMap.insert( widgets[i], itemInfo );
 }
 
 void QwtLegendMap::remove( const QVariant &itemInfo )
 {
-    for ( int i = 0; i < d_entries.size(); i++ )
+    EntryHash::iterator it = findEntry( itemInfo );
+    if ( it != d_entries.end() )
     {
-        Entry &entry = d_entries[i];
-        if ( entry.itemInfo == itemInfo )
-        {
-            d_entries.removeAt( i );
-            return;
-        }
+        const QList<QWidget *> &widgets = it.value().widgets;
+        for ( int i = 0; i < widgets.size(); i++ )
+            d_widgetMap.remove( widgets[i] );
+
+        d_entries.erase( it );
     }
 }
 
 void QwtLegendMap::removeWidget( const QWidget *widget )
 {
-    QWidget *w = const_cast<QWidget *>( widget );
-
-    for ( int i = 0; i < d_entries.size(); i++ )
-        d_entries[ i ].widgets.removeAll( w );
+    const QVariant itemInfo = d_widgetMap.take( widget );
+    if ( itemInfo.isValid() )
+    {
+        EntryHash::iterator it = findEntry( itemInfo );
+        if ( it != d_entries.end() )
+            it.value().widgets.removeAll( const_cast<QWidget *>( widget ) );
+    }
 }
 
 QVariant QwtLegendMap::itemInfo( const QWidget *widget ) const
 {
     if ( widget != NULL )
-    {
-        QWidget *w = const_cast<QWidget *>( widget );
-
-        for ( int i = 0; i < d_entries.size(); i++ )
-        {
-            const Entry &entry = d_entries[i];
-            if ( entry.widgets.indexOf( w ) >= 0 )
-                return entry.itemInfo;
-        }
-    }
+        return d_widgetMap.value( widget );
 
     return QVariant();
 }
@@ -111,12 +147,9 @@ QList<QWidget *> QwtLegendMap::legendWidgets( const QVariant &itemInfo ) const
 {
     if ( itemInfo.isValid() )
     {
-        for ( int i = 0; i < d_entries.size(); i++ )
-        {
-            const Entry &entry = d_entries[i];
-            if ( entry.itemInfo == itemInfo )
-                return entry.widgets;
-        }
+        EntryHash::const_iterator it = findEntry( itemInfo );
+        if ( it != d_entries.end() )
+            return it.value().widgets;
     }
 
     return QList<QWidget *>();
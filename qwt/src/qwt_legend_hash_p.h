@@ -0,0 +1,46 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_LEGEND_HASH_P_H
+#define QWT_LEGEND_HASH_P_H
+
+/*
+  This file is not part of the Qwt API. It is shared by
+  the implementations of QwtLegend and QwtVirtualLegend
+  and is not installed.
+ */
+
+#include "qwt_plot_item.h"
+#include <qvariant.h>
+#include <qhash.h>
+
+/*
+  Hash key for the item info of a legend entry
+
+  Plot items are hashed by their address, all other item infos
+  by their string representation - the entries with the same
+  key have to be compared by QVariant::operator==().
+ */
+static inline uint qwtItemHash( const QVariant &itemInfo )
+{
+    if ( itemInfo.userType() == qMetaTypeId<QwtPlotItem *>() )
+    {
+        // see QwtPlot::itemToInfo()
+
+        const QwtPlotItem *item = qvariant_cast<QwtPlotItem *>( itemInfo );
+        return qHash( item );
+    }
+
+    if ( itemInfo.canConvert( QVariant::String ) )
+        return qHash( itemInfo.toString() );
+
+    return 0;
+}
+
+#endif
@@ -11,31 +11,715 @@
 #include <qnumeric.h>
 #include <qmath.h>
 
+static inline void qwtConvertValue( double value, double &to )
+{
+    to = value;
+}
+
+static inline void qwtConvertValue( double value, float &to )
+{
+    to = static_cast<float>( value );
+}
+
+static inline void qwtConvertValue( double value, quint16 &to )
+{
+    // casting negative or out of range values is undefined
+    to = static_cast<quint16>( qRound( qBound( 0.0, value, 65535.0 ) ) );
+}
+
+static inline void qwtConvertValue( double value, quint8 &to )
+{
+    to = static_cast<quint8>( qRound( qBound( 0.0, value, 255.0 ) ) );
+}
+
+template <class From, class To>
+static inline void qwtCopyRow( const From *from, int count, To *to )
+{
+    for ( int i = 0; i < count; i++ )
+        qwtConvertValue( static_cast<double>( from[i] ), to[i] );
+}
+
+static inline void qwtCubicWeights( double t, double *w )
+{
+    // cubic convolution kernel with a = -0.5 ( Catmull-Rom )
+
+    w[0] = ( ( -0.5 * t + 1.0 ) * t - 0.5 ) * t;
+    w[1] = ( 1.5 * t - 2.5 ) * t * t + 1.0;
+    w[2] = ( ( -1.5 * t + 2.0 ) * t + 0.5 ) * t;
+    w[3] = ( 0.5 * t - 0.5 ) * t * t;
+}
+
+/*
+   Cells of the matrix, that are covered by a pixel of the raster.
+   The first and last cell might be covered partially only.
+ */
+class QwtResampleSpan
+{
+public:
+    QwtResampleSpan():
+        from( 0 ),
+        to( -1 ),
+        weight1( 1.0 ),
+        weight2( 1.0 )
+    {
+    }
+
+    inline bool isEmpty() const
+    {
+        return from > to;
+    }
+
+    inline double weight( int cell ) const
+    {
+        if ( cell == from )
+            return weight1;
+
+        if ( cell == to )
+            return weight2;
+
+        return 1.0;
+    }
+
+    int from;
+    int to;
+
+    double weight1;
+    double weight2;
+};
+
+/*
+   Index of the first of the 4 cells and their weights
+   for a cubic interpolation
+ */
+class QwtCubicKernel
+{
+public:
+    QwtCubicKernel():
+        from( 0 ),
+        valid( false )
+    {
+    }
+
+    int from;
+    bool valid;
+    double weights[4];
+};
+
+static QVector<QwtResampleSpan> qwtAreaSpans( 
+    double pos, double step, double min, double cellSize, 
+    int numCells, int count )
+{
+    QVector<QwtResampleSpan> spans( count );
+    if ( cellSize <= 0.0 )
+        return spans;
+
+    const double radius = 0.5 * step / cellSize;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const double center = ( pos + i * step - min ) / cellSize;
+        if ( center < 0.0 || center > numCells )
+            continue;
+
+        QwtResampleSpan &span = spans[i];
+
+        const double c1 = qMax( center - radius, 0.0 );
+        const double c2 = qMin( center + radius, double( numCells ) );
+
+        if ( c2 > c1 )
+        {
+            span.from = qMin( qFloor( c1 ), numCells - 1 );
+            span.to = qBound( span.from, qCeil( c2 ) - 1, numCells - 1 );
+
+            span.weight1 = qMin( span.from + 1.0, c2 ) - c1;
+            span.weight2 = c2 - qMax( double( span.to ), c1 );
+        }
+        else
+        {
+            span.from = span.to = qMin( int( center ), numCells - 1 );
+        }
+    }
+
+    return spans;
+}
+
+static QVector<QwtCubicKernel> qwtCubicKernels(
+    double pos, double step, double min, double cellSize, 
+    int numCells, int count )
+{
+    QVector<QwtCubicKernel> kernels( count );
+    if ( cellSize <= 0.0 )
+        return kernels;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        // the values are at the centers of the cells
+        const double center = ( pos + i * step - min ) / cellSize;
+        if ( center < 0.0 || center > numCells )
+            continue;
+
+        const double c = center - 0.5;
+        const int cell = qFloor( c );
+
+        QwtCubicKernel &kernel = kernels[i];
+        kernel.from = cell - 1;
+        kernel.valid = true;
+
+        qwtCubicWeights( c - cell, kernel.weights );
+    }
+
+    return kernels;
+}
+
 class QwtMatrixRasterData::PrivateData
 {
 public:
     PrivateData():
         resampleMode(QwtMatrixRasterData::NearestNeighbour),
-        numColumns(0)
+        valueType(QwtMatrixRasterData::Double),
+        matrix(NULL),
+        numValues(0),
+        numColumns(0),
+        scale(1.0),
+        offset(0.0)
     {
     }
 
+    template <class T>
     inline double value(int row, int col) const
     {
-        return values.data()[ row * numColumns + col ];
+        const T *v = static_cast<const T *>( matrix );
+        return v[ row * numColumns + col ] * scale + offset;
+    }
+
+    template <class T>
+    double resample( double x, double y,
+        const QwtInterval &xInterval, const QwtInterval &yInterval ) const;
+
+    template <class T>
+    void resampleRaster( const QRectF &area, const QSize &size );
+
+    template <class T>
+    void aggregateRow( int row, 
+        const QVector<QwtResampleSpan> &spans, double *values ) const;
+
+    template <class T>
+    void interpolateRow( int row, 
+        const QVector<QwtCubicKernel> &kernels, double *values ) const;
+
+    template <class T>
+    void areaRaster( const QVector<QwtResampleSpan> &xSpans,
+        const QVector<QwtResampleSpan> &ySpans, double *values ) const;
+
+    template <class T>
+    void bicubicRaster( const QVector<QwtCubicKernel> &xKernels,
+        const QVector<QwtCubicKernel> &yKernels, double *values ) const;
+
+    inline bool rasterValue( double x, double y, double &value ) const
+    {
+        const int w = rasterSize.width();
+        const int h = rasterSize.height();
+
+        double col = 0.0;
+        if ( rasterArea.width() > 0.0 )
+            col = ( x - rasterArea.left() ) * w / rasterArea.width();
+
+        double row = 0.0;
+        if ( rasterArea.height() > 0.0 )
+            row = ( y - rasterArea.top() ) * h / rasterArea.height();
+
+        /*
+            The raster is only valid for positions on its grid. Any
+            other position - f.e. from a non linear scale map or
+            a half pixel offset - needs to be resampled directly.
+         */
+        const int c = qRound( col );
+        const int r = qRound( row );
+
+        if ( c < 0 || c >= w || r < 0 || r >= h )
+            return false;
+
+        const double eps = 1e-3;
+        if ( qAbs( col - c ) > eps || qAbs( row - r ) > eps )
+            return false;
+
+        value = rasterValues[ r * w + c ];
+        return true;
+    }
+
+    inline void clearRaster()
+    {
+        rasterArea = QRectF();
+        rasterSize = QSize();
+        rasterValues.clear();
+    }
+
+    // returns a writable pointer to the values, NULL for external buffers
+    void *detach()
+    {
+        void *v = NULL;
+
+        switch( valueType )
+        {
+            case QwtMatrixRasterData::Float:
+                if ( matrix == floatValues.constData() )
+                    v = floatValues.data();
+                break;
+
+            case QwtMatrixRasterData::UInt16:
+                if ( matrix == uint16Values.constData() )
+                    v = uint16Values.data();
+                break;
+
+            case QwtMatrixRasterData::UInt8:
+                if ( matrix == uint8Values.constData() )
+                    v = uint8Values.data();
+                break;
+
+            case QwtMatrixRasterData::Double:
+            default:
+                if ( matrix == doubleValues.constData() )
+                    v = doubleValues.data();
+        }
+
+        if ( v )
+            matrix = v;
+
+        return v;
+    }
+
+    template <class T>
+    bool setRow( int row, const T *values )
+    {
+        if ( values == NULL || row < 0 || row >= numRows )
+            return false;
+
+        void *v = detach();
+        if ( v == NULL )
+            return false;
+
+        const int index = row * numColumns;
+
+        switch( valueType )
+        {
+            case QwtMatrixRasterData::Float:
+                qwtCopyRow( values, numColumns, static_cast<float *>( v ) + index );
+                break;
+
+            case QwtMatrixRasterData::UInt16:
+                qwtCopyRow( values, numColumns, static_cast<quint16 *>( v ) + index );
+                break;
+
+            case QwtMatrixRasterData::UInt8:
+                qwtCopyRow( values, numColumns, static_cast<quint8 *>( v ) + index );
+                break;
+
+            case QwtMatrixRasterData::Double:
+            default:
+                qwtCopyRow( values, numColumns, static_cast<double *>( v ) + index );
+        }
+
+        return true;
+    }
+
+    void reset( QwtMatrixRasterData::ValueType type )
+    {
+        valueType = type;
+
+        doubleValues.clear();
+        floatValues.clear();
+        uint16Values.clear();
+        uint8Values.clear();
+
+        matrix = NULL;
+        numValues = 0;
     }
 
     QwtInterval intervals[3];
     QwtMatrixRasterData::ResampleMode resampleMode;
 
-    QVector<double> values;
+    QwtMatrixRasterData::ValueType valueType;
+
+    QVector<double> doubleValues;
+    QVector<float> floatValues;
+    QVector<quint16> uint16Values;
+    QVector<quint8> uint8Values;
+
+    // one of the vectors above or an external buffer
+    const void *matrix;
+    int numValues;
+
     int numColumns;
     int numRows;
 
     double dx;
     double dy;
+
+    double scale;
+    double offset;
+
+    // values resampled in initRaster()
+    QRectF rasterArea;
+    QSize rasterSize;
+    QVector<double> rasterValues;
 };
 
+template <class T>
+double QwtMatrixRasterData::PrivateData::resample( double x, double y,
+    const QwtInterval &xInterval, const QwtInterval &yInterval ) const
+{
+    double v;
+
+    switch( resampleMode )
+    {
+        case BilinearInterpolation:
+        {
+            int col1 = qRound( (x - xInterval.minValue() ) / dx ) - 1;
+            int row1 = qRound( (y - yInterval.minValue() ) / dy ) - 1;
+            int col2 = col1 + 1;
+            int row2 = row1 + 1;
+
+            if ( col1 < 0 )
+                col1 = col2;
+            else if ( col2 >= static_cast<int>( numColumns ) )
+                col2 = col1;
+
+            if ( row1 < 0 )
+                row1 = row2;
+            else if ( row2 >= static_cast<int>( numRows ) )
+                row2 = row1;
+
+            const double v11 = this->value<T>( row1, col1 );
+            const double v21 = this->value<T>( row1, col2 );
+            const double v12 = this->value<T>( row2, col1 );
+            const double v22 = this->value<T>( row2, col2 );
+
+            const double x2 = xInterval.minValue() + ( col2 + 0.5 ) * dx;
+            const double y2 = yInterval.minValue() + ( row2 + 0.5 ) * dy;
+                
+            const double rx = ( x2 - x ) / dx;
+            const double ry = ( y2 - y ) / dy;
+
+            const double vr1 = rx * v11 + ( 1.0 - rx ) * v21;
+            const double vr2 = rx * v12 + ( 1.0 - rx ) * v22;
+
+            v = ry * vr1 + ( 1.0 - ry ) * vr2;
+
+            break;
+        }
+        case BicubicInterpolation:
+        {
+            const double cx = ( x - xInterval.minValue() ) / dx - 0.5;
+            const double cy = ( y - yInterval.minValue() ) / dy - 0.5;
+
+            const int col = qFloor( cx );
+            const int row = qFloor( cy );
+
+            double wx[4], wy[4];
+            qwtCubicWeights( cx - col, wx );
+            qwtCubicWeights( cy - row, wy );
+
+            v = 0.0;
+            for ( int j = 0; j < 4; j++ )
+            {
+                const int r = qBound( 0, row - 1 + j, numRows - 1 );
+
+                double vr = 0.0;
+                for ( int i = 0; i < 4; i++ )
+                {
+                    const int c = qBound( 0, col - 1 + i, numColumns - 1 );
+                    vr += wx[i] * this->value<T>( r, c );
+                }
+
+                v += wy[j] * vr;
+            }
+
+            break;
+        }
+        case NearestNeighbour:
+        default:
+        {
+            int row = int( (y - yInterval.minValue() ) / dy );
+            int col = int( (x - xInterval.minValue() ) / dx );
+
+            // In case of intervals, where the maximum is included
+            // we get out of bound for row/col, when the value for the
+            // maximum is requested. Instead we return the value
+            // from the last row/col
+
+            if ( row >= numRows )
+                row = numRows - 1;
+
+            if ( col >= numColumns )
+                col = numColumns - 1;
+
+            v = this->value<T>( row, col );
+        }
+    }
+
+    return v;
+}
+
+template <class T>
+void QwtMatrixRasterData::PrivateData::resampleRaster( 
+    const QRectF &area, const QSize &size )
+{
+    /*
+        The same grid as the vertices of QwtRasterData::contourRaster():
+        the pixels start at the left/top border of the area
+        with a step of a width/height divided by the size.
+     */
+    const int w = size.width();
+    const int h = size.height();
+
+    const double stepX = area.width() / w;
+    const double stepY = area.height() / h;
+
+    const double minX = intervals[Qt::XAxis].minValue();
+    const double minY = intervals[Qt::YAxis].minValue();
+
+    rasterValues.resize( w * h );
+
+    if ( resampleMode == BicubicInterpolation )
+    {
+        const QVector<QwtCubicKernel> xKernels = qwtCubicKernels( 
+            area.left(), stepX, minX, dx, numColumns, w );
+
+        const QVector<QwtCubicKernel> yKernels = qwtCubicKernels( 
+            area.top(), stepY, minY, dy, numRows, h );
+
+        bicubicRaster<T>( xKernels, yKernels, rasterValues.data() );
+    }
+    else
+    {
+        const QVector<QwtResampleSpan> xSpans = qwtAreaSpans( 
+            area.left(), stepX, minX, dx, numColumns, w );
+
+        const QVector<QwtResampleSpan> ySpans = qwtAreaSpans( 
+            area.top(), stepY, minY, dy, numRows, h );
+
+        areaRaster<T>( xSpans, ySpans, rasterValues.data() );
+    }
+
+    rasterArea = area;
+    rasterSize = size;
+}
+
+template <class T>
+void QwtMatrixRasterData::PrivateData::aggregateRow( int row,
+    const QVector<QwtResampleSpan> &spans, double *values ) const
+{
+    const T *v = static_cast<const T *>( matrix ) + row * numColumns;
+
+    for ( int i = 0; i < spans.size(); i++ )
+    {
+        const QwtResampleSpan &span = spans[i];
+
+        double value = qQNaN();
+
+        if ( resampleMode == AreaMean )
+        {
+            double sum = 0.0;
+            double sumWeights = 0.0;
+
+            for ( int col = span.from; col <= span.to; col++ )
+            {
+                const double cellValue = v[col] * scale + offset;
+                if ( !qIsNaN( cellValue ) )
+                {
+                    const double weight = span.weight( col );
+
+                    sum += weight * cellValue;
+                    sumWeights += weight;
+                }
+            }
+
+            if ( sumWeights > 0.0 )
+                value = sum / sumWeights;
+        }
+        else
+        {
+            const bool isMin = ( resampleMode == AreaMinimum );
+
+            for ( int col = span.from; col <= span.to; col++ )
+            {
+                const double cellValue = v[col] * scale + offset;
+                if ( qIsNaN( cellValue ) )
+                    continue;
+
+                if ( qIsNaN( value ) || 
+                    ( isMin ? cellValue < value : cellValue > value ) )
+                {
+                    value = cellValue;
+                }
+            }
+        }
+
+        values[i] = value;
+    }
+}
+
+template <class T>
+void QwtMatrixRasterData::PrivateData::interpolateRow( int row,
+    const QVector<QwtCubicKernel> &kernels, double *values ) const
+{
+    const T *v = static_cast<const T *>( matrix ) + row * numColumns;
+
+    for ( int i = 0; i < kernels.size(); i++ )
+    {
+        const QwtCubicKernel &kernel = kernels[i];
+        if ( !kernel.valid )
+        {
+            values[i] = qQNaN();
+            continue;
+        }
+
+        double value = 0.0;
+        for ( int k = 0; k < 4; k++ )
+        {
+            const int col = qBound( 0, kernel.from + k, numColumns - 1 );
+            value += kernel.weights[k] * ( v[col] * scale + offset );
+        }
+
+        values[i] = value;
+    }
+}
+
+template <class T>
+void QwtMatrixRasterData::PrivateData::areaRaster(
+    const QVector<QwtResampleSpan> &xSpans,
+    const QVector<QwtResampleSpan> &ySpans, double *values ) const
+{
+    /*
+        Each row of the matrix, that is covered by the raster
+        is aggregated horizontally first, the aggregated 
+        rows are combined vertically then. Only rows at the borders
+        of the pixels are processed twice.
+     */
+
+    const int w = xSpans.size();
+
+    QVector<double> rowValues( w );
+    QVector<double> sums( w );
+    QVector<double> sumWeights( w );
+
+    for ( int j = 0; j < ySpans.size(); j++ )
+    {
+        const QwtResampleSpan &ySpan = ySpans[j];
+        double *out = values + j * w;
+
+        for ( int i = 0; i < w; i++ )
+            out[i] = qQNaN();
+
+        if ( resampleMode == AreaMean )
+        {
+            sums.fill( 0.0 );
+            sumWeights.fill( 0.0 );
+        }
+
+        for ( int row = ySpan.from; row <= ySpan.to; row++ )
+        {
+            aggregateRow<T>( row, xSpans, rowValues.data() );
+
+            if ( resampleMode == AreaMean )
+            {
+                const double weight = ySpan.weight( row );
+
+                for ( int i = 0; i < w; i++ )
+                {
+                    if ( !qIsNaN( rowValues[i] ) )
+                    {
+                        sums[i] += weight * rowValues[i];
+                        sumWeights[i] += weight;
+                    }
+                }
+            }
+            else
+            {
+                const bool isMin = ( resampleMode == AreaMinimum );
+
+                for ( int i = 0; i < w; i++ )
+                {
+                    const double value = rowValues[i];
+                    if ( qIsNaN( value ) )
+                        continue;
+
+                    if ( qIsNaN( out[i] ) || 
+                        ( isMin ? value < out[i] : value > out[i] ) )
+                    {
+                        out[i] = value;
+                    }
+                }
+            }
+        }
+
+        if ( resampleMode == AreaMean )
+        {
+            for ( int i = 0; i < w; i++ )
+            {
+                if ( sumWeights[i] > 0.0 )
+                    out[i] = sums[i] / sumWeights[i];
+            }
+        }
+    }
+}
+
+template <class T>
+void QwtMatrixRasterData::PrivateData::bicubicRaster(
+    const QVector<QwtCubicKernel> &xKernels,
+    const QVector<QwtCubicKernel> &yKernels, double *values ) const
+{
+    /*
+        The rows of the matrix are interpolated horizontally first.
+        When zooming in, neighboured pixels share the same 4 rows,
+        so that the interpolated rows are reused.
+     */
+
+    const int w = xKernels.size();
+
+    QVector<double> rows[4];
+    for ( int k = 0; k < 4; k++ )
+        rows[k].resize( w );
+
+    bool hasRows = false;
+    int from = 0;
+
+    for ( int j = 0; j < yKernels.size(); j++ )
+    {
+        const QwtCubicKernel &kernel = yKernels[j];
+        double *out = values + j * w;
+
+        if ( !kernel.valid )
+        {
+            for ( int i = 0; i < w; i++ )
+                out[i] = qQNaN();
+
+            continue;
+        }
+
+        if ( !hasRows || kernel.from != from )
+        {
+            for ( int k = 0; k < 4; k++ )
+            {
+                const int row = qBound( 0, kernel.from + k, numRows - 1 );
+                interpolateRow<T>( row, xKernels, rows[k].data() );
+            }
+
+            from = kernel.from;
+            hasRows = true;
+        }
+
+        for ( int i = 0; i < w; i++ )
+        {
+            double value = 0.0;
+            for ( int k = 0; k < 4; k++ )
+                value += kernel.weights[k] * rows[k][i];
+
+            out[i] = value;
+        }
+    }
+}
+
 //! Constructor
 QwtMatrixRasterData::QwtMatrixRasterData()
 {
@@ -58,6 +742,7 @@ QwtMatrixRasterData::~QwtMatrixRasterData()
 void QwtMatrixRasterData::setResampleMode( ResampleMode mode )
 {
     d_data->resampleMode = mode;
+    d_data->clearRaster();
 }
 
 /*!
@@ -123,37 +808,330 @@ QwtInterval QwtMatrixRasterData::interval( Qt::Axis axis ) const
 void QwtMatrixRasterData::setValueMatrix( 
     const QVector<double> &values, int numColumns )
 {
-    d_data->values = values;
+    d_data->reset( Double );
+
+    d_data->doubleValues = values;
+    d_data->matrix = d_data->doubleValues.constData();
+    d_data->numValues = values.size();
+    d_data->numColumns = qMax( numColumns, 0 );
+
+    update();
+}
+
+/*!
+   \brief Assign a matrix of floats
+
+   As QVector is implicitely shared, the values are not copied
+   as long as neither the application nor the raster data modifies them.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+
+   \sa valueType(), setValueScale(), setRawValueMatrix()
+*/
+void QwtMatrixRasterData::setValueMatrix( 
+    const QVector<float> &values, int numColumns )
+{
+    d_data->reset( Float );
+
+    d_data->floatValues = values;
+    d_data->matrix = d_data->floatValues.constData();
+    d_data->numValues = values.size();
+    d_data->numColumns = qMax( numColumns, 0 );
+
+    update();
+}
+
+/*!
+   \brief Assign a matrix of 16 bit unsigned integers
+
+   \param values Vector of values
+   \param numColumns Number of columns
+
+   \sa valueType(), setValueScale(), setRawValueMatrix()
+*/
+void QwtMatrixRasterData::setValueMatrix( 
+    const QVector<quint16> &values, int numColumns )
+{
+    d_data->reset( UInt16 );
+
+    d_data->uint16Values = values;
+    d_data->matrix = d_data->uint16Values.constData();
+    d_data->numValues = values.size();
     d_data->numColumns = qMax( numColumns, 0 );
+
+    update();
+}
+
+/*!
+   \brief Assign a matrix of 8 bit unsigned integers
+
+   \param values Vector of values
+   \param numColumns Number of columns
+
+   \sa valueType(), setValueScale(), setRawValueMatrix()
+*/
+void QwtMatrixRasterData::setValueMatrix( 
+    const QVector<quint8> &values, int numColumns )
+{
+    d_data->reset( UInt8 );
+
+    d_data->uint8Values = values;
+    d_data->matrix = d_data->uint8Values.constData();
+    d_data->numValues = values.size();
+    d_data->numColumns = qMax( numColumns, 0 );
+
+    update();
+}
+
+/*!
+   \brief Assign an external buffer of values
+
+   The values are not copied and the buffer has to remain valid, 
+   as long as it is assigned to the raster data. Modifications
+   of the buffer are visible with the next replot, but neither
+   setValue() nor setRawRowValues() can be used for external buffers.
+
+   \param type Type of the values
+   \param values Buffer of numColumns * numRows values in row major order
+   \param numColumns Number of columns
+   \param numRows Number of rows
+
+   \sa setValueMatrix(), setValueScale()
+*/
+void QwtMatrixRasterData::setRawValueMatrix( ValueType type, 
+    const void *values, int numColumns, int numRows )
+{
+    d_data->reset( type );
+
+    if ( values && numColumns > 0 && numRows > 0 )
+    {
+        d_data->matrix = values;
+        d_data->numValues = numColumns * numRows;
+        d_data->numColumns = numColumns;
+    }
+    else
+    {
+        d_data->numColumns = 0;
+    }
+
     update();
 }
 
 /*!
    \return Value matrix
+
+   When the value type is not Double or scale and offset are set,
+   the values are converted including scale and offset.
+
    \sa setValueMatrix(), numColumns(), numRows(), setInterval()
 */
 const QVector<double> QwtMatrixRasterData::valueMatrix() const
 {
-    return d_data->values;
+    if ( d_data->valueType == Double
+        && d_data->matrix == d_data->doubleValues.constData()
+        && d_data->scale == 1.0 && d_data->offset == 0.0 )
+    {
+        return d_data->doubleValues;
+    }
+
+    QVector<double> values( d_data->numValues );
+    for ( int i = 0; i < d_data->numValues; i++ )
+    {
+        const int row = i / qMax( d_data->numColumns, 1 );
+        const int col = i - row * d_data->numColumns;
+
+        switch( d_data->valueType )
+        {
+            case Float:
+                values[i] = d_data->value<float>( row, col );
+                break;
+            case UInt16:
+                values[i] = d_data->value<quint16>( row, col );
+                break;
+            case UInt8:
+                values[i] = d_data->value<quint8>( row, col );
+                break;
+            case Double:
+            default:
+                values[i] = d_data->value<double>( row, col );
+        }
+    }
+
+    return values;
+}
+
+/*!
+   \return Type of the values stored in the matrix
+   \sa setValueMatrix(), setRawValueMatrix()
+*/
+QwtMatrixRasterData::ValueType QwtMatrixRasterData::valueType() const
+{
+    return d_data->valueType;
+}
+
+/*!
+   \brief Set a linear transformation for the stored values
+
+   The value of a cell is calculated by: storedValue * scale + offset.
+   The default setting is a scale of 1.0 and an offset of 0.0.
+
+   \param scale Scale factor
+   \param offset Offset
+
+   \sa valueScale(), valueOffset(), value()
+*/
+void QwtMatrixRasterData::setValueScale( double scale, double offset )
+{
+    d_data->scale = scale;
+    d_data->offset = offset;
+    d_data->clearRaster();
+}
+
+/*!
+   \return Scale factor for the stored values
+   \sa setValueScale()
+*/
+double QwtMatrixRasterData::valueScale() const
+{
+    return d_data->scale;
+}
+
+/*!
+   \return Offset for the stored values
+   \sa setValueScale()
+*/
+double QwtMatrixRasterData::valueOffset() const
+{
+    return d_data->offset;
 }
 
 /*!
   \brief Change a single value in the matrix
 
+  The value is translated back according to setValueScale()
+  and converted to valueType(). For integer types the result
+  is rounded and bounded to the range of the type.
+
   \param row Row index
   \param col Column index
   \param value New value
 
-  \sa value(), setValueMatrix()
+  \return false, when the position is outside of the matrix, or the
+          values are stored in an external buffer ( see setRawValueMatrix() )
+
+  \sa value(), setValueMatrix(), setRawRowValues()
 */
-void QwtMatrixRasterData::setValue( int row, int col, double value )
+bool QwtMatrixRasterData::setValue( int row, int col, double value )
 {
-    if ( row >= 0 && row < d_data->numRows &&
-        col >= 0 && col < d_data->numColumns )
+    if ( row < 0 || row >= d_data->numRows ||
+        col < 0 || col >= d_data->numColumns )
     {
-        const int index = row * d_data->numColumns + col;
-        d_data->values.data()[ index ] = value;
+        return false;
     }
+
+    void *values = d_data->detach();
+    if ( values == NULL )
+        return false;
+
+    const int index = row * d_data->numColumns + col;
+
+    double v = value;
+    if ( d_data->scale != 0.0 )
+        v = ( value - d_data->offset ) / d_data->scale;
+
+    switch( d_data->valueType )
+    {
+        case Float:
+            qwtConvertValue( v, static_cast<float *>( values )[ index ] );
+            break;
+        case UInt16:
+            qwtConvertValue( v, static_cast<quint16 *>( values )[ index ] );
+            break;
+        case UInt8:
+            qwtConvertValue( v, static_cast<quint8 *>( values )[ index ] );
+            break;
+        case Double:
+        default:
+            qwtConvertValue( v, static_cast<double *>( values )[ index ] );
+    }
+
+    return true;
+}
+
+/*!
+  \brief Overwrite a row of the matrix with stored values
+
+  In opposite to setValue() the values are not translated back
+  according to setValueScale(). They are only converted
+  to valueType(), where integer values are rounded and bounded
+  to the range of the type.
+
+  \param row Row index
+  \param values numColumns() values
+
+  \return false, when row is invalid or the values are stored
+          in an external buffer ( see setRawValueMatrix() )
+
+  \sa setValue(), setValueMatrix()
+*/
+bool QwtMatrixRasterData::setRawRowValues( int row, const double *values )
+{
+    return d_data->setRow( row, values );
+}
+
+/*!
+  \brief Overwrite a row of the matrix with stored values
+
+  When valueType() is Float no conversion is necessary.
+
+  \param row Row index
+  \param values numColumns() values
+
+  \return false, when row is invalid or the values are stored
+          in an external buffer ( see setRawValueMatrix() )
+
+  \sa setValue(), setValueMatrix()
+*/
+bool QwtMatrixRasterData::setRawRowValues( int row, const float *values )
+{
+    return d_data->setRow( row, values );
+}
+
+/*!
+  \brief Overwrite a row of the matrix with stored values
+
+  When valueType() is UInt16 no conversion is necessary.
+
+  \param row Row index
+  \param values numColumns() values
+
+  \return false, when row is invalid or the values are stored
+          in an external buffer ( see setRawValueMatrix() )
+
+  \sa setValue(), setValueMatrix()
+*/
+bool QwtMatrixRasterData::setRawRowValues( int row, const quint16 *values )
+{
+    return d_data->setRow( row, values );
+}
+
+/*!
+  \brief Overwrite a row of the matrix with stored values
+
+  When valueType() is UInt8 no conversion is necessary.
+
+  \param row Row index
+  \param values numColumns() values
+
+  \return false, when row is invalid or the values are stored
+          in an external buffer ( see setRawValueMatrix() )
+
+  \sa setValue(), setValueMatrix()
+*/
+bool QwtMatrixRasterData::setRawRowValues( int row, const quint8 *values )
+{
+    return d_data->setRow( row, values );
 }
 
 /*!
@@ -185,7 +1163,7 @@ int QwtMatrixRasterData::numRows() const
      pixelHint() returns the surrounding pixel of the top left value 
      in the matrix.
 
-   - BilinearInterpolation\n
+   - BilinearInterpolation, BicubicInterpolation and the Area modes\n
      Returns an empty rectangle recommending
      to render in target device ( f.e. screen ) resolution. 
 
@@ -216,10 +1194,16 @@ QRectF QwtMatrixRasterData::pixelHint( const QRectF &area ) const
 /*!
    \return the value at a raster position
 
+   When the values have been resampled in initRaster() and the
+   position is on the grid of the raster, the value of the raster
+   is returned. Otherwise - f.e. for non linear scale maps - the value
+   is resampled for the position, where the Area modes fall back
+   to NearestNeighbour.
+
    \param x X value in plot coordinates
    \param y Y value in plot coordinates
 
-   \sa ResampleMode
+   \sa ResampleMode, initRaster()
 */
 double QwtMatrixRasterData::value( double x, double y ) const
 {
@@ -229,80 +1213,108 @@ double QwtMatrixRasterData::value( double x, double y ) const
     if ( !( xInterval.contains(x) && yInterval.contains(y) ) )
         return qQNaN();
 
-    double value;
+    if ( d_data->matrix == NULL || d_data->numRows <= 0 )
+        return qQNaN();
+
+    double v;
+    if ( !d_data->rasterValues.isEmpty() && d_data->rasterValue( x, y, v ) )
+        return v;
 
-    switch( d_data->resampleMode )
+    switch( d_data->valueType )
     {
-        case BilinearInterpolation:
-        {
-            int col1 = qRound( (x - xInterval.minValue() ) / d_data->dx ) - 1;
-            int row1 = qRound( (y - yInterval.minValue() ) / d_data->dy ) - 1;
-            int col2 = col1 + 1;
-            int row2 = row1 + 1;
+        case Float:
+            return d_data->resample<float>( x, y, xInterval, yInterval );
 
-            if ( col1 < 0 )
-                col1 = col2;
-            else if ( col2 >= static_cast<int>( d_data->numColumns ) )
-                col2 = col1;
+        case UInt16:
+            return d_data->resample<quint16>( x, y, xInterval, yInterval );
 
-            if ( row1 < 0 )
-                row1 = row2;
-            else if ( row2 >= static_cast<int>( d_data->numRows ) )
-                row2 = row1;
+        case UInt8:
+            return d_data->resample<quint8>( x, y, xInterval, yInterval );
 
-            const double v11 = d_data->value( row1, col1 );
-            const double v21 = d_data->value( row1, col2 );
-            const double v12 = d_data->value( row2, col1 );
-            const double v22 = d_data->value( row2, col2 );
+        case Double:
+        default:
+            return d_data->resample<double>( x, y, xInterval, yInterval );
+    }
+}
 
-            const double x2 = xInterval.minValue() + 
-                ( col2 + 0.5 ) * d_data->dx;
-            const double y2 = yInterval.minValue() + 
-                ( row2 + 0.5 ) * d_data->dy;
-                
-            const double rx = ( x2 - x ) / d_data->dx;
-            const double ry = ( y2 - y ) / d_data->dy;
+/*!
+  \brief Initialize a raster
 
-            const double vr1 = rx * v11 + ( 1.0 - rx ) * v21;
-            const double vr2 = rx * v12 + ( 1.0 - rx ) * v22;
+  For BicubicInterpolation and the Area modes the values of
+  all pixels of the raster are resampled in advance. This is 
+  done in separable passes over the rows and columns of the matrix,
+  what is much faster than resampling each value individually.
 
-            value = ry * vr1 + ( 1.0 - ry ) * vr2;
+  The pixels are located on the same grid as the vertices of
+  QwtRasterData::contourRaster(): pixel ( x, y ) is at
+  ( area.x() + x * area.width() / raster.width(),
+    area.y() + y * area.height() / raster.height() ).
+  Other positions are resampled by value().
 
-            break;
-        }
-        case NearestNeighbour:
-        default:
-        {
-            int row = int( (y - yInterval.minValue() ) / d_data->dy );
-            int col = int( (x - xInterval.minValue() ) / d_data->dx );
+  \param area Area of the raster
+  \param raster Number of horizontal and vertical pixels
 
-            // In case of intervals, where the maximum is included
-            // we get out of bound for row/col, when the value for the
-            // maximum is requested. Instead we return the value
-            // from the last row/col
+  \sa discardRaster(), value(), ResampleMode
+*/
+void QwtMatrixRasterData::initRaster( 
+    const QRectF &area, const QSize &raster )
+{
+    d_data->clearRaster();
 
-            if ( row >= d_data->numRows )
-                row = d_data->numRows - 1;
+    if ( d_data->resampleMode == NearestNeighbour ||
+        d_data->resampleMode == BilinearInterpolation )
+    {
+        return;
+    }
 
-            if ( col >= d_data->numColumns )
-                col = d_data->numColumns - 1;
+    if ( d_data->matrix == NULL || d_data->numRows <= 0 
+        || raster.isEmpty() )
+    {
+        return;
+    }
 
-            value = d_data->value( row, col );
-        }
+    const QRectF rect = area.normalized();
+
+    switch( d_data->valueType )
+    {
+        case Float:
+            d_data->resampleRaster<float>( rect, raster );
+            break;
+
+        case UInt16:
+            d_data->resampleRaster<quint16>( rect, raster );
+            break;
+
+        case UInt8:
+            d_data->resampleRaster<quint8>( rect, raster );
+            break;
+
+        case Double:
+        default:
+            d_data->resampleRaster<double>( rect, raster );
     }
+}
 
-    return value;
+/*!
+  \brief Discard the values resampled in initRaster()
+  \sa initRaster()
+*/
+void QwtMatrixRasterData::discardRaster()
+{
+    d_data->clearRaster();
 }
 
 void QwtMatrixRasterData::update()
 {
+    d_data->clearRaster();
+
     d_data->numRows = 0;
     d_data->dx = 0.0;
     d_data->dy = 0.0;
 
     if ( d_data->numColumns > 0 )
     {
-        d_data->numRows = d_data->values.size() / d_data->numColumns;
+        d_data->numRows = d_data->numValues / d_data->numColumns;
 
         const QwtInterval xInterval = interval( Qt::XAxis );
         const QwtInterval yInterval = interval( Qt::YAxis );
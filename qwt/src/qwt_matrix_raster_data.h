@@ -21,6 +21,23 @@
   equidistant values, that can be used by a QwtPlotRasterItem. 
   It implements a couple of resampling algorithms, to provide
   values for positions, that or not on the value matrix.
+
+  Beside doubles the matrix might store floats or unsigned
+  integers of 8 or 16 bits, what reduces the memory footprint
+  for data from f.e. sensors or cameras. The stored values are 
+  translated into values by: value = storedValue * scale + offset.
+
+  Instead of copying a matrix of values into the raster data,
+  an external buffer can be assigned by setRawValueMatrix().
+
+  For BicubicInterpolation and the Area modes all values of a raster
+  are resampled at once in initRaster(), running separable 
+  horizontal and vertical passes over the matrix. value() then 
+  returns the precalculated value for the requested position.
+  The Area modes are the right choice for displaying dense matrices,
+  where many values are mapped to the same pixel.
+
+  \sa setValueScale()
 */
 class QWT_EXPORT QwtMatrixRasterData: public QwtRasterData
 {
@@ -41,7 +58,44 @@ public:
           Interpolate the value from the distances and values of the 
           4 surrounding values in the matrix,
          */
-        BilinearInterpolation
+        BilinearInterpolation,
+
+        /*!
+          Interpolate the value from the 16 surrounding values 
+          using a cubic convolution ( Catmull-Rom ) kernel.
+         */
+        BicubicInterpolation,
+
+        /*!
+          Mean of the values in the matrix, that are covered by 
+          a pixel of the raster, weighted by the covered area.
+         */
+        AreaMean,
+
+        //! Minimum of the values, that are covered by a pixel of the raster
+        AreaMinimum,
+
+        //! Maximum of the values, that are covered by a pixel of the raster
+        AreaMaximum
+    };
+
+    /*!
+      \brief Type of the values stored in the matrix
+      \sa setValueMatrix(), setRawValueMatrix()
+     */
+    enum ValueType
+    {
+        //! double
+        Double,
+
+        //! float
+        Float,
+
+        //! quint16
+        UInt16,
+
+        //! quint8
+        UInt8
     };
 
     QwtMatrixRasterData();
@@ -54,15 +108,35 @@ public:
     QwtInterval interval( Qt::Axis axis) const;
 
     void setValueMatrix( const QVector<double> &values, int numColumns );
+    void setValueMatrix( const QVector<float> &values, int numColumns );
+    void setValueMatrix( const QVector<quint16> &values, int numColumns );
+    void setValueMatrix( const QVector<quint8> &values, int numColumns );
+
+    void setRawValueMatrix( ValueType, const void *values,
+        int numColumns, int numRows );
+
     const QVector<double> valueMatrix() const;
+    ValueType valueType() const;
 
-    void setValue( int row, int col, double value );
+    void setValueScale( double scale, double offset = 0.0 );
+    double valueScale() const;
+    double valueOffset() const;
+
+    bool setValue( int row, int col, double value );
+
+    bool setRawRowValues( int row, const double *values );
+    bool setRawRowValues( int row, const float *values );
+    bool setRawRowValues( int row, const quint16 *values );
+    bool setRawRowValues( int row, const quint8 *values );
 
     int numColumns() const;
     int numRows() const;
 
     virtual QRectF pixelHint( const QRectF & ) const;
 
+    virtual void initRaster( const QRectF &, const QSize& raster );
+    virtual void discardRaster();
+
     virtual double value( double x, double y ) const;
 
 private:
@@ -78,7 +78,13 @@ bool QwtNullPaintDevice::PaintEngine::begin( QPaintDevice * )
 
 bool QwtNullPaintDevice::PaintEngine::end()
 {
+    QwtNullPaintDevice *device = nullDevice();
+
     setActive( false );
+
+    if ( device )
+        device->endPaint();
+
     return true;
 }
 
@@ -591,3 +597,16 @@ void QwtNullPaintDevice::updateState(
 {
     Q_UNUSED(state);
 }
+
+/*!
+  \brief Notification, that a painter has finished painting on the device
+
+  endPaint() is called from QPainter::end() and can be overloaded
+  to postprocess what has been painted. The default implementation
+  does nothing.
+
+  \sa QPaintEngine::end()
+ */
+void QwtNullPaintDevice::endPaint()
+{
+}
@@ -115,6 +115,8 @@ protected:
     //! \return Size needed to implement metric()
     virtual QSize sizeMetrics() const = 0;
 
+    virtual void endPaint();
+
 private:
     class PaintEngine;
     PaintEngine *d_engine;
@@ -27,6 +27,8 @@
 #include <qpaintengine.h>
 #include <qapplication.h>
 #include <qdesktopwidget.h>
+#include <qthreadstorage.h>
+#include <qmath.h>
 
 #if QT_VERSION >= 0x050000
 #include <qwindow.h>
@@ -43,6 +45,16 @@
 bool QwtPainter::d_polylineSplitting = true;
 bool QwtPainter::d_roundingAlignment = true;
 
+// the vector resolution is set by QwtPlotRenderer for the
+// time of rendering. As scenes might be rendered in worker
+// threads, while the GUI thread is rendering too, it is stored
+// per thread.
+static QThreadStorage<double *> qwtVectorResolution;
+
+// the device for the text metrics is set by QwtPlotRenderer
+// for the time of rendering a scene
+static QThreadStorage<QPaintDevice **> qwtMetricsDevice;
+
 static inline bool qwtIsRasterPaintEngineBuggy()
 {
 #if 0
@@ -202,18 +214,34 @@ static inline QSize qwtScreenResolution()
     return screenResolution;
 }
 
+static inline QSize qwtMetricsResolution()
+{
+    if ( qwtMetricsDevice.hasLocalData() )
+    {
+        const QPaintDevice *pd = *qwtMetricsDevice.localData();
+        if ( pd )
+            return QSize( pd->logicalDpiX(), pd->logicalDpiY() );
+    }
+
+    return qwtScreenResolution();
+}
+
 static inline void qwtUnscaleFont( QPainter *painter )
 {
     if ( painter->font().pixelSize() >= 0 )
         return;
 
-    const QSize screenResolution = qwtScreenResolution();
+    const QSize metricsResolution = qwtMetricsResolution();
 
     const QPaintDevice *pd = painter->device();
-    if ( pd->logicalDpiX() != screenResolution.width() ||
-        pd->logicalDpiY() != screenResolution.height() )
+    if ( pd->logicalDpiX() != metricsResolution.width() ||
+        pd->logicalDpiY() != metricsResolution.height() )
     {
-        QFont pixelFont( painter->font(), QApplication::desktop() );
+        QPaintDevice *metricsDevice = QwtPainter::metricsDevice();
+        if ( metricsDevice == NULL )
+            metricsDevice = QApplication::desktop();
+
+        QFont pixelFont( painter->font(), metricsDevice );
         pixelFont.setPixelSize( QFontInfo( pixelFont ).pixelSize() );
 
         painter->setFont( pixelFont );
@@ -301,6 +329,128 @@ void QwtPainter::setRoundingAlignment( bool enable )
     d_roundingAlignment = enable;
 }
 
+/*!
+  \brief Set an effective resolution for non aligning paint devices
+
+  When painting to devices, where no rounding alignment happens
+  ( PDF, SVG, or a scaled painter ), each point of a polyline ends up
+  in the document, even if many of them are indistinguishable.
+  Setting a resolution allows the painting code ( f.e QwtPlotCurve )
+  to reduce its output to what is visible at this resolution.
+
+  The setting is stored for the calling thread only. It is usually
+  set by QwtPlotRenderer for the time of rendering a plot.
+
+  \param dotsPerInch Effective resolution, <= 0.0 disables it
+  \sa vectorResolution(), vectorPixelSize(), 
+      QwtPlotRenderer::setVectorResolution()
+*/
+void QwtPainter::setVectorResolution( double dotsPerInch )
+{
+    if ( dotsPerInch <= 0.0 )
+    {
+        if ( qwtVectorResolution.hasLocalData() )
+            qwtVectorResolution.setLocalData( NULL );
+    }
+    else
+    {
+        if ( qwtVectorResolution.hasLocalData() )
+            *qwtVectorResolution.localData() = dotsPerInch;
+        else
+            qwtVectorResolution.setLocalData( new double( dotsPerInch ) );
+    }
+}
+
+/*!
+  \return Effective resolution for non aligning paint devices
+           of the calling thread, or 0.0, when it is disabled
+  \sa setVectorResolution()
+*/
+double QwtPainter::vectorResolution()
+{
+    if ( qwtVectorResolution.hasLocalData() )
+    {
+        const double *dotsPerInch = qwtVectorResolution.localData();
+        if ( dotsPerInch )
+            return *dotsPerInch;
+    }
+
+    return 0.0;
+}
+
+/*!
+  \brief Set the paint device for calculating text metrics
+
+  Texts are laid out in the metrics of a reference device and
+  QwtPainter::drawText() scales them to the resolution of the device
+  it is painting on. By default the reference is the screen
+  ( QApplication::desktop() ), what can't be accessed outside
+  of the GUI thread.
+
+  The setting is stored for the calling thread only. It is set by
+  QwtPlotRenderer for the time of rendering a scene, so that the
+  texts are laid out in the metrics of the target device.
+
+  \param device Reference device, NULL for the screen
+  \sa metricsDevice(), QwtPlotRenderer::renderScene()
+*/
+void QwtPainter::setMetricsDevice( QPaintDevice *device )
+{
+    if ( device == NULL )
+    {
+        if ( qwtMetricsDevice.hasLocalData() )
+            qwtMetricsDevice.setLocalData( NULL );
+    }
+    else
+    {
+        if ( qwtMetricsDevice.hasLocalData() )
+            *qwtMetricsDevice.localData() = device;
+        else
+            qwtMetricsDevice.setLocalData( new QPaintDevice *( device ) );
+    }
+}
+
+/*!
+  \return Paint device, whose resolution is used for text metrics
+          in the calling thread, or NULL for the screen
+  \sa setMetricsDevice()
+*/
+QPaintDevice *QwtPainter::metricsDevice()
+{
+    if ( qwtMetricsDevice.hasLocalData() )
+        return *qwtMetricsDevice.localData();
+
+    return NULL;
+}
+
+/*!
+  \brief Size of a pixel at the vector resolution
+
+  \param painter Painter
+  \return Size of a pixel at vectorResolution() in the coordinates of the
+          painter, or 0.0, when the painter is aligning or no
+          vector resolution has been set
+
+  \sa setVectorResolution(), isAligning()
+*/
+double QwtPainter::vectorPixelSize( const QPainter *painter )
+{
+    const double dotsPerInch = vectorResolution();
+
+    if ( dotsPerInch <= 0.0 || painter == NULL || !painter->isActive() )
+        return 0.0;
+
+    if ( isAligning( const_cast<QPainter *>( painter ) ) )
+        return 0.0;
+
+    const QTransform tr = painter->combinedTransform();
+    const double scale = qSqrt( tr.m11() * tr.m11() + tr.m12() * tr.m12() );
+    if ( scale <= 0.0 )
+        return 0.0;
+
+    return painter->device()->logicalDpiX() / ( dotsPerInch * scale );
+}
+
 /*!
   \brief En/Disable line splitting for the raster paint engine
 
@@ -362,6 +512,24 @@ void QwtPainter::drawRect( QPainter *painter, const QRectF &rect )
     painter->drawRect( r );
 }
 
+//! Wrapper for QPainter::drawRects()
+void QwtPainter::drawRects( QPainter *painter,
+    const QRectF *rects, int rectCount )
+{
+    QRectF clipRect;
+    const bool deviceClipping = qwtIsClippingNeeded( painter, clipRect );
+
+    if ( deviceClipping )
+    {
+        for ( int i = 0; i < rectCount; i++ )
+            drawRect( painter, rects[i] );
+
+        return;
+    }
+
+    painter->drawRects( rects, rectCount );
+}
+
 //! Wrapper for QPainter::fillRect()
 void QwtPainter::fillRect( QPainter *painter,
     const QRectF &rect, const QBrush &brush )
@@ -481,7 +649,7 @@ void QwtPainter::drawSimpleRichText( QPainter *painter, const QRectF &rect,
 
     if ( painter->font().pixelSize() < 0 )
     {
-        const QSize res = qwtScreenResolution();
+        const QSize res = qwtMetricsResolution();
 
         const QPaintDevice *pd = painter->device();
         if ( pd->logicalDpiX() != res.width() ||
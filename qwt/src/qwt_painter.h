@@ -19,6 +19,7 @@
 #include <qpalette.h>
 
 class QPainter;
+class QPaintDevice;
 class QBrush;
 class QColor;
 class QWidget;
@@ -46,6 +47,13 @@ public:
     static bool roundingAlignment();
     static bool roundingAlignment(QPainter *);
 
+    static void setVectorResolution( double dotsPerInch );
+    static double vectorResolution();
+    static double vectorPixelSize( const QPainter * );
+
+    static void setMetricsDevice( QPaintDevice * );
+    static QPaintDevice *metricsDevice();
+
     static void drawText( QPainter *, double x, double y, const QString & );
     static void drawText( QPainter *, const QPointF &, const QString & );
     static void drawText( QPainter *, double x, double y, double w, double h,
@@ -60,6 +68,7 @@ public:
 
     static void drawRect( QPainter *, double x, double y, double w, double h );
     static void drawRect( QPainter *, const QRectF &rect );
+    static void drawRects( QPainter *, const QRectF *rects, int rectCount );
     static void fillRect( QPainter *, const QRectF &, const QBrush & );
 
     static void drawEllipse( QPainter *, const QRectF & );
@@ -15,6 +15,7 @@
 #include <qevent.h>
 #include <qcursor.h>
 #include <qbitmap.h>
+#include <qmath.h>
 
 static QVector<QwtPicker *> qwtActivePickers( QWidget *w )
 {
@@ -44,7 +45,9 @@ public:
         restoreCursor( NULL ),
         hasCursor( false ),
 #endif
-        isEnabled( false )
+        isEnabled( false ),
+        overscan( 0.0 ),
+        overscanTimerId( 0 )
     {
         orientations = Qt::Vertical | Qt::Horizontal;
     }
@@ -76,6 +79,13 @@ public:
 #endif
     bool isEnabled;
     Qt::Orientations orientations;
+
+    double overscan;
+    int overscanTimerId;
+
+    // geometry of the overscan pixmap in widget coordinates
+    QRect overscanRect;
+    QPixmap overscanPixmap;
 };
 
 /*!
@@ -232,6 +242,37 @@ bool QwtPanner::isOrientationEnabled( Qt::Orientation o ) const
     return d_data->orientations & o;
 }
 
+/*!
+  \brief Set the size of the overscan
+
+  The overscan is a margin around the widget, that is rendered
+  by grabOverscan(), so that the areas, that are dragged into the
+  widget are not empty. To avoid delays at the beginning of the 
+  panning, the overscan is rendered with the next pass of the event 
+  loop - until then the content grabbed by grab() is displayed.
+
+  The default setting is 0.0, what disables the overscan.
+
+  \param ratio Width/height of the margin on each side
+               as a fraction of the width/height of the widget
+
+  \sa overscan(), grabOverscan()
+*/
+void QwtPanner::setOverscan( double ratio )
+{
+    d_data->overscan = qMax( ratio, 0.0 );
+}
+
+/*!
+  \return Width/height of the overscan margins as fraction of
+          the width/height of the widget
+  \sa setOverscan()
+*/
+double QwtPanner::overscan() const
+{
+    return d_data->overscan;
+}
+
 /*!
   \return true when enabled, false otherwise
   \sa setEnabled, eventFilter()
@@ -262,7 +303,12 @@ void QwtPanner::paintEvent( QPaintEvent *pe )
 
     QPainter painter( &pm );
 
-    if ( !d_data->contentsMask.isNull() )
+    if ( !d_data->overscanPixmap.isNull() )
+    {
+        painter.drawPixmap( d_data->overscanRect.translated( dx, dy ), 
+            d_data->overscanPixmap );
+    }
+    else if ( !d_data->contentsMask.isNull() )
     {
         QPixmap masked = d_data->pixmap;
         masked.setMask( d_data->contentsMask );
@@ -310,6 +356,108 @@ QPixmap QwtPanner::grab() const
 #endif
 }
 
+/*!
+  \brief Render the content of the overscan
+
+  The default implementation returns a null pixmap indicating,
+  that the widget has no content beyond its borders. 
+
+  An implementation, that renders the overscan asynchronously,
+  returns a null pixmap and passes the content later
+  by setOverscanPixmap().
+
+  \param rect Area to be rendered in widget coordinates, 
+              that includes the overscan margins
+  \return Pixmap with the content of rect
+
+  \sa setOverscan()
+*/
+QPixmap QwtPanner::grabOverscan( const QRect &rect ) const
+{
+    Q_UNUSED( rect );
+    return QPixmap();
+}
+
+/*!
+  \brief Assign the content of the overscan
+
+  The pixmap is displayed instead of the grabbed content of
+  the widget, until the panning is finished. It is ignored,
+  when the widget is not panned.
+
+  \param rect Geometry of the pixmap in widget coordinates,
+              usually the rectangle passed to grabOverscan()
+  \param pixmap Content of rect
+
+  \sa grabOverscan(), overscanPixmap()
+*/
+void QwtPanner::setOverscanPixmap(
+    const QRect &rect, const QPixmap &pixmap )
+{
+    if ( !isVisible() || pixmap.isNull() )
+        return;
+
+    d_data->overscanRect = rect;
+    d_data->overscanPixmap = pixmap;
+
+    update();
+}
+
+/*!
+  \return Content of the overscan, or a null pixmap, when the
+          overscan has not been rendered ( yet )
+
+  The pixmap is valid until the panned() signal has been processed.
+
+  \sa overscanRect(), setOverscanPixmap()
+*/
+QPixmap QwtPanner::overscanPixmap() const
+{
+    return d_data->overscanPixmap;
+}
+
+/*!
+  \return Geometry of overscanPixmap() in widget coordinates,
+          before the widget has been moved
+  \sa overscanPixmap(), setOverscanPixmap()
+*/
+QRect QwtPanner::overscanRect() const
+{
+    return d_data->overscanRect;
+}
+
+/*!
+  Timer event, rendering the overscan
+  \param event Timer event
+*/
+void QwtPanner::timerEvent( QTimerEvent *event )
+{
+    if ( event->timerId() != d_data->overscanTimerId )
+    {
+        QWidget::timerEvent( event );
+        return;
+    }
+
+    killTimer( d_data->overscanTimerId );
+    d_data->overscanTimerId = 0;
+
+    if ( !isVisible() || d_data->overscan <= 0.0 )
+        return;
+
+    QWidget *w = parentWidget();
+    if ( w == NULL )
+        return;
+
+    const int mx = isOrientationEnabled( Qt::Horizontal )
+        ? qCeil( d_data->overscan * w->width() ) : 0;
+    const int my = isOrientationEnabled( Qt::Vertical )
+        ? qCeil( d_data->overscan * w->height() ) : 0;
+
+    const QRect rect = w->rect().adjusted( -mx, -my, mx, my );
+
+    setOverscanPixmap( rect, grabOverscan( rect ) );
+}
+
 /*!
   \brief Event filter
 
@@ -408,6 +556,9 @@ void QwtPanner::widgetMousePressEvent( QMouseEvent *mouseEvent )
         pickers[i]->setEnabled( true );
 
     show();
+
+    if ( d_data->overscan > 0.0 && d_data->overscanTimerId == 0 )
+        d_data->overscanTimerId = startTimer( 0 );
 }
 
 /*!
@@ -459,15 +610,17 @@ void QwtPanner::widgetMouseReleaseEvent( QMouseEvent *mouseEvent )
         if ( !isOrientationEnabled( Qt::Vertical ) )
             pos.setY( d_data->initialPos.y() );
 
-        d_data->pixmap = QPixmap();
-        d_data->contentsMask = QBitmap();
         d_data->pos = pos;
 
+        // the overscan might be reused, when processing panned()
+
         if ( d_data->pos != d_data->initialPos )
         {
             Q_EMIT panned( d_data->pos.x() - d_data->initialPos.x(),
                 d_data->pos.y() - d_data->initialPos.y() );
         }
+
+        resetPixmaps();
     }
 }
 
@@ -487,7 +640,7 @@ void QwtPanner::widgetKeyPressEvent( QKeyEvent *keyEvent )
 #ifndef QT_NO_CURSOR
         showCursor( false );
 #endif
-        d_data->pixmap = QPixmap();
+        resetPixmaps();
     }
 }
 
@@ -502,6 +655,21 @@ void QwtPanner::widgetKeyReleaseEvent( QKeyEvent *keyEvent )
     Q_UNUSED( keyEvent );
 }
 
+void QwtPanner::resetPixmaps()
+{
+    if ( d_data->overscanTimerId != 0 )
+    {
+        killTimer( d_data->overscanTimerId );
+        d_data->overscanTimerId = 0;
+    }
+
+    d_data->pixmap = QPixmap();
+    d_data->contentsMask = QBitmap();
+
+    d_data->overscanPixmap = QPixmap();
+    d_data->overscanRect = QRect();
+}
+
 #ifndef QT_NO_CURSOR
 void QwtPanner::showCursor( bool on )
 {
@@ -31,6 +31,14 @@ class QCursor;
 
   For widgets, where repaints are very fast it might be better to
   implement panning manually by mapping mouse events into paint events.
+
+  To avoid empty areas at the borders, an overscan can be enabled.
+  Then the content of a margin around the widget is rendered
+  by grabOverscan() with the first pass of the event loop after
+  the panning has been started. Content, that is rendered
+  asynchronously, can be passed later by setOverscanPixmap().
+
+  \sa setOverscan()
 */
 class QWT_EXPORT QwtPanner: public QWidget
 {
@@ -59,6 +67,9 @@ public:
 
     bool isOrientationEnabled( Qt::Orientation ) const;
 
+    void setOverscan( double ratio );
+    double overscan() const;
+
     virtual bool eventFilter( QObject *, QEvent * );
 
 Q_SIGNALS:
@@ -87,14 +98,21 @@ protected:
     virtual void widgetKeyReleaseEvent( QKeyEvent * );
 
     virtual void paintEvent( QPaintEvent * );
+    virtual void timerEvent( QTimerEvent * );
 
     virtual QBitmap contentsMask() const;
     virtual QPixmap grab() const;
+    virtual QPixmap grabOverscan( const QRect & ) const;
+
+    void setOverscanPixmap( const QRect &, const QPixmap & );
+    QPixmap overscanPixmap() const;
+    QRect overscanRect() const;
 
 private:
 #ifndef QT_NO_CURSOR
     void showCursor( bool );
 #endif
+    void resetPixmaps();
 
     class PrivateData;
     PrivateData *d_data;
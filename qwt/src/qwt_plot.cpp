@@ -16,12 +16,20 @@
 #include "qwt_legend.h"
 #include "qwt_legend_data.h"
 #include "qwt_plot_canvas.h"
+#include "qwt_scale_div.h"
+#include "qwt_painter.h"
+#include "qwt_scale_map_p.h"
 #include <qmath.h>
 #include <qpainter.h>
+#include <qimage.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
 #include <qpointer.h>
 #include <qpaintengine.h>
 #include <qapplication.h>
 #include <qevent.h>
+#include <qelapsedtimer.h>
 
 static inline void qwtEnableLegendItems( QwtPlot *plot, bool on )
 {
@@ -91,9 +99,80 @@ static void qwtSetTabOrder(
     }
 }
 
+static inline void qwtDrawItem( QPainter *painter, QwtPlotItem *item,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap, 
+    const QRectF &canvasRect )
+{
+    painter->save();
+
+    painter->setRenderHint( QPainter::Antialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+    painter->setRenderHint( QPainter::HighQualityAntialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+    item->draw( painter, xMap, yMap, canvasRect );
+
+    painter->restore();
+}
+
+static void qwtRenderItem( QImage *image, QwtPlotItem *item,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap, 
+    const QRectF &canvasRect )
+{
+    QPainter painter( image );
+    qwtDrawItem( &painter, item, xMap, yMap, canvasRect );
+}
+
+static QImage qwtCanvasImage( const QWidget *canvas )
+{
+#if QT_VERSION >= 0x050000
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( canvas );
+
+    QImage image( canvas->size() * pixelRatio, 
+        QImage::Format_ARGB32_Premultiplied );
+    image.setDevicePixelRatio( pixelRatio );
+#else
+    QImage image( canvas->size(), QImage::Format_ARGB32_Premultiplied );
+#endif
+    image.fill( 0 );
+
+    return image;
+}
+
+/*
+   Consecutive static or dynamic items. The content of
+   static items is cached in an image.
+ */
+class QwtPlotLayer
+{
+public:
+    QwtPlotLayer():
+        isDynamic( false ),
+        isValid( false )
+    {
+    }
+
+    bool isDynamic;
+    bool isValid;
+
+    QwtPlotItemList items;
+    QImage image;
+};
+
 class QwtPlot::PrivateData
 {
 public:
+    PrivateData():
+        deferredReplot( false ),
+        maxReplotRate( 0.0 ),
+        replotTimerId( 0 ),
+        isFlushing( false ),
+        replotCount( 0 ),
+        mergedReplotCount( 0 ),
+        paintAttributes( 0 )
+    {
+    }
+
     QPointer<QwtTextLabel> titleLabel;
     QPointer<QwtTextLabel> footerLabel;
     QPointer<QWidget> canvas;
@@ -101,6 +180,23 @@ public:
     QwtPlotLayout *layout;
 
     bool autoReplot;
+
+    bool deferredReplot;
+    double maxReplotRate;
+    int replotTimerId;
+    bool isFlushing;
+    QElapsedTimer replotTime;
+
+    uint replotCount;
+    uint mergedReplotCount;
+
+    QwtPlot::PaintAttributes paintAttributes;
+
+    // geometry and scales of the cached layers
+    QList<QwtPlotLayer> layers;
+    QRectF layerRect;
+    QwtScaleMap layerMaps[QwtPlot::axisCnt];
+    QwtScaleDiv layerScaleDivs[QwtPlot::axisCnt];
 };
 
 /*!
@@ -325,6 +421,213 @@ bool QwtPlot::autoReplot() const
     return d_data->autoReplot;
 }
 
+/*!
+  \brief En/Disable deferred replots
+
+  In deferred mode replot() only marks the plot as dirty. All requests,
+  that arrive before the control returns to the event loop are merged
+  into one replot, that is executed from a timer event. Together with
+  autoReplot() this avoids that a burst of modifications - like
+  attaching items or assigning samples - results in many replots.
+
+  When a synchronous update is needed ( f.e. because the scales are
+  read afterwards ) flushReplot() executes a pending replot immediately.
+
+  The default setting is false.
+
+  \param on On/Off
+  \sa deferredReplot(), setMaxReplotRate(), flushReplot(), replot()
+*/
+void QwtPlot::setDeferredReplot( bool on )
+{
+    if ( on != d_data->deferredReplot )
+    {
+        d_data->deferredReplot = on;
+        if ( !on )
+            flushReplot();
+    }
+}
+
+/*!
+  \return True, when deferred replots are enabled
+  \sa setDeferredReplot()
+*/
+bool QwtPlot::deferredReplot() const
+{
+    return d_data->deferredReplot;
+}
+
+/*!
+  \brief Limit the rate of deferred replots
+
+  When a deferred replot is requested earlier than 1000 / rate
+  milliseconds after the previous replot, it is postponed, so that
+  the plot is not updated more often than rate times per second.
+  A rate <= 0.0 means, that deferred replots are executed with the next 
+  pass of the event loop.
+
+  The default setting is 0.0.
+
+  \param rate Maximum number of replots per second
+  \sa maxReplotRate(), setDeferredReplot()
+*/
+void QwtPlot::setMaxReplotRate( double rate )
+{
+    d_data->maxReplotRate = qMax( rate, 0.0 );
+}
+
+/*!
+  \return Maximum number of deferred replots per second
+  \sa setMaxReplotRate()
+*/
+double QwtPlot::maxReplotRate() const
+{
+    return d_data->maxReplotRate;
+}
+
+/*!
+  \return True, when a deferred replot has been requested, 
+          but not executed yet
+  \sa setDeferredReplot(), flushReplot()
+*/
+bool QwtPlot::isReplotPending() const
+{
+    return d_data->replotTimerId != 0;
+}
+
+/*!
+  \brief Execute a pending deferred replot immediately
+
+  When no replot is pending, flushReplot() does nothing.
+  \sa isReplotPending(), setDeferredReplot()
+*/
+void QwtPlot::flushReplot()
+{
+    if ( d_data->replotTimerId == 0 )
+        return;
+
+    killTimer( d_data->replotTimerId );
+    d_data->replotTimerId = 0;
+
+    d_data->isFlushing = true;
+    replot();
+    d_data->isFlushing = false;
+}
+
+/*!
+  \return Number of replots, that have been executed since the last
+          call of resetReplotStatistics()
+
+  \note Canvas replots triggered by QwtPlotMatrix::flushReplot()
+        are not counted.
+  \sa mergedReplotCount()
+*/
+uint QwtPlot::replotCount() const
+{
+    return d_data->replotCount;
+}
+
+/*!
+  \return Number of deferred replot requests, that have been merged
+          into other replots since the last call of 
+          resetReplotStatistics()
+  \sa replotCount(), setDeferredReplot()
+*/
+uint QwtPlot::mergedReplotCount() const
+{
+    return d_data->mergedReplotCount;
+}
+
+/*!
+  \brief Reset the counters for replots
+  \sa replotCount(), mergedReplotCount()
+*/
+void QwtPlot::resetReplotStatistics()
+{
+    d_data->replotCount = 0;
+    d_data->mergedReplotCount = 0;
+}
+
+void QwtPlot::scheduleReplot()
+{
+    if ( d_data->replotTimerId != 0 )
+    {
+        d_data->mergedReplotCount++;
+        return;
+    }
+
+    int interval = 0;
+    if ( d_data->maxReplotRate > 0.0 && d_data->replotTime.isValid() )
+    {
+        const qint64 minInterval = qRound( 1000.0 / d_data->maxReplotRate );
+        const qint64 elapsed = d_data->replotTime.elapsed();
+
+        if ( elapsed < minInterval )
+            interval = static_cast<int>( minInterval - elapsed );
+    }
+
+    d_data->replotTimerId = startTimer( interval );
+}
+
+/*!
+  Qt timer event, executing deferred replots
+  \param event Timer event
+*/
+void QwtPlot::timerEvent( QTimerEvent *event )
+{
+    if ( event->timerId() == d_data->replotTimerId )
+    {
+        flushReplot();
+        return;
+    }
+
+    QFrame::timerEvent( event );
+}
+
+/*!
+  \brief Change a paint attribute
+
+  \param attribute Paint attribute
+  \param on On/Off
+
+  \sa testPaintAttribute(), invalidateLayerCache()
+*/
+void QwtPlot::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        d_data->paintAttributes |= attribute;
+    else
+        d_data->paintAttributes &= ~attribute;
+
+    if ( attribute == LayerCache && !on )
+        d_data->layers.clear();
+}
+
+/*!
+  \return True, when attribute is enabled
+  \param attribute Paint attribute
+  \sa setPaintAttribute()
+*/
+bool QwtPlot::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return d_data->paintAttributes & attribute;
+}
+
+/*!
+  \brief Invalidate all cached layers
+
+  The layers are rendered again with the next replot.
+  Calling invalidateLayerCache() is only necessary for
+  static items, that have been modified without calling
+  QwtPlotItem::itemChanged().
+
+  \sa LayerCache, QwtPlotItem::Dynamic
+*/
+void QwtPlot::invalidateLayerCache()
+{
+    d_data->layers.clear();
+}
+
 /*!
   Change the plot's title
   \param title New title
@@ -541,10 +844,19 @@ void QwtPlot::resizeEvent( QResizeEvent *e )
   or if any curves are attached to raw data, the plot has to
   be refreshed explicitly in order to make changes visible.
 
-  \sa updateAxes(), setAutoReplot()
+  In deferred mode the replot is postponed and merged with other
+  requests - see setDeferredReplot().
+
+  \sa updateAxes(), setAutoReplot(), setDeferredReplot()
 */
 void QwtPlot::replot()
 {
+    if ( d_data->deferredReplot && !d_data->isFlushing )
+    {
+        scheduleReplot();
+        return;
+    }
+
     bool doAutoReplot = autoReplot();
     setAutoReplot( false );
 
@@ -569,6 +881,9 @@ void QwtPlot::replot()
     }
 
     setAutoReplot( doAutoReplot );
+
+    d_data->replotCount++;
+    d_data->replotTime.start();
 }
 
 /*!
@@ -579,6 +894,14 @@ void QwtPlot::updateLayout()
 {
     d_data->layout->activate( this, contentsRect() );
 
+    /*
+        The geometries are always applied, as widgets might have been
+        replaced ( f.e by setCanvas() ) without changing the layout.
+        Setting an unchanged geometry is cheap, the masks of the
+        scale widgets are updated only for changed rectangles.
+     */
+    const QwtPlotLayout::LayoutRects changed = d_data->layout->changedRects();
+
     QRect titleRect = d_data->layout->titleRect().toRect();
     QRect footerRect = d_data->layout->footerRect().toRect();
     QRect scaleRect[QwtPlot::axisCnt];
@@ -592,6 +915,7 @@ void QwtPlot::updateLayout()
     if ( !d_data->titleLabel->text().isEmpty() )
     {
         d_data->titleLabel->setGeometry( titleRect );
+
         if ( !d_data->titleLabel->isVisibleTo( this ) )
             d_data->titleLabel->show();
     }
@@ -601,6 +925,7 @@ void QwtPlot::updateLayout()
     if ( !d_data->footerLabel->text().isEmpty() )
     {
         d_data->footerLabel->setGeometry( footerRect );
+
         if ( !d_data->footerLabel->isVisibleTo( this ) )
             d_data->footerLabel->show();
     }
@@ -611,10 +936,18 @@ void QwtPlot::updateLayout()
     {
         if ( axisEnabled( axisId ) )
         {
+            const QwtPlotLayout::LayoutRect scaleFlag =
+                static_cast<QwtPlotLayout::LayoutRect>(
+                    QwtPlotLayout::YLeftScaleRect << axisId );
+
             axisWidget( axisId )->setGeometry( scaleRect[axisId] );
 
 #if 1
-            if ( axisId == xBottom || axisId == xTop )
+            const QwtPlotLayout::LayoutRects maskFlags = scaleFlag
+                | QwtPlotLayout::YLeftScaleRect | QwtPlotLayout::YRightScaleRect;
+
+            if ( ( axisId == xBottom || axisId == xTop )
+                && ( changed & maskFlags ) )
             {
                 // do we need this code any longer ???
 
@@ -645,11 +978,13 @@ void QwtPlot::updateLayout()
         else
         {
             d_data->legend->setGeometry( legendRect );
+
             d_data->legend->show();
         }
     }
 
-    d_data->canvas->setGeometry( canvasRect );
+    if ( d_data->canvas )
+        d_data->canvas->setGeometry( canvasRect );
 }
 
 /*!
@@ -733,7 +1068,11 @@ void QwtPlot::updateCanvasMargins()
   \warning drawCanvas calls drawItems what is also used
            for printing. Applications that like to add individual
            plot items better overload drawItems()
-  \sa drawItems()
+
+  \note When LayerCache is enabled the items are composed from
+        cached layers instead of calling drawItems()
+
+  \sa drawItems(), LayerCache
 */
 void QwtPlot::drawCanvas( QPainter *painter )
 {
@@ -741,7 +1080,31 @@ void QwtPlot::drawCanvas( QPainter *painter )
     for ( int axisId = 0; axisId < axisCnt; axisId++ )
         maps[axisId] = canvasMap( axisId );
 
-    drawItems( painter, d_data->canvas->contentsRect(), maps );
+    const QRectF canvasRect = d_data->canvas->contentsRect();
+
+    if ( testPaintAttribute( LayerCache ) )
+    {
+        drawLayers( painter, canvasRect, maps );
+    }
+    else if ( testPaintAttribute( ParallelRendering ) )
+    {
+        QwtPlotItemList items;
+
+        const QwtPlotItemList& itmList = itemList();
+        for ( QwtPlotItemIterator it = itmList.begin();
+            it != itmList.end(); ++it )
+        {
+            QwtPlotItem *item = *it;
+            if ( item && item->isVisible() )
+                items += item;
+        }
+
+        drawItemList( painter, items, canvasRect, maps );
+    }
+    else
+    {
+        drawItems( painter, canvasRect, maps );
+    }
 }
 
 /*!
@@ -767,18 +1130,189 @@ void QwtPlot::drawItems( QPainter *painter, const QRectF &canvasRect,
         QwtPlotItem *item = *it;
         if ( item && item->isVisible() )
         {
-            painter->save();
+            qwtDrawItem( painter, item, 
+                maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+        }
+    }
+}
+
+void QwtPlot::drawLayers( QPainter *painter, const QRectF &canvasRect,
+    const QwtScaleMap maps[axisCnt] )
+{
+    const QWidget *canvas = d_data->canvas;
 
-            painter->setRenderHint( QPainter::Antialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
-            painter->setRenderHint( QPainter::HighQualityAntialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+#if QT_VERSION >= 0x050000
+    const QSize imageSize = 
+        canvas->size() * QwtPainter::devicePixelRatio( canvas );
+#else
+    const QSize imageSize = canvas->size();
+#endif
 
-            item->draw( painter,
-                maps[item->xAxis()], maps[item->yAxis()],
-                canvasRect );
+    bool isValid = ( canvasRect == d_data->layerRect );
+    for ( int axisId = 0; isValid && axisId < axisCnt; axisId++ )
+    {
+        isValid = qwtIsSameMap( maps[axisId], d_data->layerMaps[axisId] )
+            && axisScaleDiv( axisId ) == d_data->layerScaleDivs[axisId];
+    }
 
-            painter->restore();
+    if ( !isValid )
+    {
+        d_data->layers.clear();
+
+        d_data->layerRect = canvasRect;
+        for ( int axisId = 0; axisId < axisCnt; axisId++ )
+        {
+            d_data->layerMaps[axisId] = maps[axisId];
+            d_data->layerScaleDivs[axisId] = axisScaleDiv( axisId );
+        }
+    }
+
+    QList<QwtPlotLayer> layers;
+
+    const QwtPlotItemList& itmList = itemList();
+    for ( QwtPlotItemIterator it = itmList.begin();
+        it != itmList.end(); ++it )
+    {
+        QwtPlotItem *item = *it;
+        if ( item == NULL || !item->isVisible() )
+            continue;
+
+        const bool isDynamic = item->testItemAttribute( QwtPlotItem::Dynamic );
+        if ( layers.isEmpty() || layers.last().isDynamic != isDynamic )
+        {
+            QwtPlotLayer layer;
+            layer.isDynamic = isDynamic;
+
+            layers += layer;
+        }
+
+        layers.last().items += item;
+    }
+
+    for ( int i = 0; i < layers.size(); i++ )
+    {
+        QwtPlotLayer &layer = layers[i];
+
+        if ( layer.isDynamic )
+        {
+            drawItemList( painter, layer.items, canvasRect, maps );
+            continue;
+        }
+
+        for ( int j = 0; j < d_data->layers.size(); j++ )
+        {
+            const QwtPlotLayer &cachedLayer = d_data->layers[j];
+            if ( cachedLayer.isValid && !cachedLayer.isDynamic
+                && cachedLayer.image.size() == imageSize
+                && cachedLayer.items == layer.items )
+            {
+                layer.image = cachedLayer.image;
+                layer.isValid = true;
+                break;
+            }
+        }
+
+        if ( !layer.isValid )
+        {
+            layer.image = qwtCanvasImage( canvas );
+
+            QPainter layerPainter( &layer.image );
+            layerPainter.setClipRect( canvasRect );
+
+            drawItemList( &layerPainter, layer.items, canvasRect, maps );
+
+            layerPainter.end();
+
+            layer.isValid = true;
+        }
+
+        painter->drawImage( QPointF( 0.0, 0.0 ), layer.image );
+    }
+
+    d_data->layers = layers;
+}
+
+void QwtPlot::drawItemList( QPainter *painter, const QwtPlotItemList &items,
+    const QRectF &canvasRect, const QwtScaleMap maps[axisCnt] ) const
+{
+#if !defined(QT_NO_QFUTURE)
+    int numThreadSafe = 0;
+    if ( testPaintAttribute( ParallelRendering ) 
+        && QThread::idealThreadCount() > 1 )
+    {
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            if ( items[i]->testItemAttribute( QwtPlotItem::ThreadSafeRendering ) )
+                numThreadSafe++;
+        }
+    }
+
+    if ( numThreadSafe > 1 )
+    {
+        /*
+            The thread safe items are rendered into images
+            by the thread pool, while the others are painted
+            in between. The images are composed in z order.
+         */
+
+        QVector<QImage> images( items.size() );
+        QImage *itemImages = images.data();
+
+        QVector<int> futureIndexes( items.size() );
+        QList< QFuture<void> > futures;
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            QwtPlotItem *item = items[i];
+
+            futureIndexes[i] = -1;
+            if ( item->testItemAttribute( QwtPlotItem::ThreadSafeRendering ) )
+            {
+                itemImages[i] = qwtCanvasImage( d_data->canvas );
+
+                futureIndexes[i] = futures.size();
+                futures += QtConcurrent::run( &qwtRenderItem, &itemImages[i],
+                    item, maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+            }
+        }
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            QwtPlotItem *item = items[i];
+
+            if ( futureIndexes[i] >= 0 )
+            {
+                futures[ futureIndexes[i] ].waitForFinished();
+                painter->drawImage( QPointF( 0.0, 0.0 ), itemImages[i] );
+            }
+            else
+            {
+                qwtDrawItem( painter, item, 
+                    maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+            }
+        }
+
+        return;
+    }
+#endif
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        QwtPlotItem *item = items[i];
+        qwtDrawItem( painter, item, 
+            maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+    }
+}
+
+void QwtPlot::invalidateLayer( const QwtPlotItem *item )
+{
+    for ( int i = 0; i < d_data->layers.size(); i++ )
+    {
+        QwtPlotLayer &layer = d_data->layers[i];
+        if ( !layer.isDynamic && 
+            layer.items.contains( const_cast<QwtPlotItem *>( item ) ) )
+        {
+            layer.isValid = false;
         }
     }
 }
@@ -1081,6 +1615,8 @@ void QwtPlot::updateLegendItems( const QVariant &itemInfo,
  */
 void QwtPlot::attachItem( QwtPlotItem *plotItem, bool on )
 {
+    invalidateLayer( plotItem );
+
     if ( plotItem->testItemInterest( QwtPlotItem::LegendInterest ) )
     {
         // plotItem is some sort of legend
@@ -128,6 +128,85 @@ public:
         TopLegend
     };
 
+    /*!
+      \brief Paint attributes
+
+      The default setting disables all attributes.
+
+      \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        /*!
+          The visible items are split into layers of consecutive
+          ( in z order ) static and dynamic items - see QwtPlotItem::Dynamic. 
+          Each layer of static items is rendered into an image, that
+          is reused as long as none of its items has changed
+          and the scales and the geometry of the canvas are the same.
+          Dynamic items are always painted directly.
+
+          This is useful for plots, where a few lightweight items are
+          updated frequently on top of heavy items like spectrograms,
+          grids or zones, that rarely change.
+
+          \note Static items need to indicate their modifications
+                by QwtPlotItem::itemChanged(). Otherwise 
+                invalidateLayerCache() has to be called.
+
+          \note drawItems() is bypassed, when drawing the canvas 
+                with the LayerCache attribute.
+
+          \sa invalidateLayerCache(), drawCanvas()
+         */
+        LayerCache = 0x01,
+
+        /*!
+          Items with the QwtPlotItem::ThreadSafeRendering attribute
+          are rendered in parallel by the thread pool of QtConcurrent.
+          Each of them is painted into its own image - with its own 
+          QPainter - and the images are composed in z order with the
+          other items, that are painted in the GUI thread.
+
+          As rendering to an image and composing it is not for free,
+          this mode is intended for plots with several expensive items
+          on a system with many cores.
+
+          The canvas is painted from the GUI thread and replot() returns
+          not before all items have been rendered. So series data, that
+          is only modified from the GUI thread, can be accessed without
+          any locking. Data modified by other threads need to be 
+          synchronized by the application.
+
+          \note Like LayerCache ParallelRendering bypasses drawItems(), when
+                painting the canvas.
+          \note ParallelRendering has no effect, when Qt has been built
+                without QFuture/QtConcurrent support.
+
+          \sa QwtPlotItem::ThreadSafeRendering
+         */
+        ParallelRendering = 0x02,
+
+        /*!
+          For autoscaled axes the scale division is recalculated in
+          updateAxes() only, when the bounding interval of the items
+          has changed or a setting of the axis has been modified.
+
+          Together with QwtPlotItem::BoundingRectCache this avoids
+          scanning the samples and dividing the scales for each replot.
+
+          \note Modifications of a scale engine, that is already
+                assigned ( f.e. QwtScaleEngine::setAttribute() ),
+                are not detected. In this case the engine has to be
+                passed again to setAxisScaleEngine().
+
+          \sa updateAxes(), QwtPlotItem::BoundingRectCache
+         */
+        ScaleDivCache = 0x04
+    };
+
+    //! Paint attributes
+    typedef QFlags<PaintAttribute> PaintAttributes;
+
     explicit QwtPlot( QWidget * = NULL );
     explicit QwtPlot( const QwtText &title, QWidget * = NULL );
 
@@ -139,6 +218,24 @@ public:
     void setAutoReplot( bool = true );
     bool autoReplot() const;
 
+    void setDeferredReplot( bool = true );
+    bool deferredReplot() const;
+
+    void setMaxReplotRate( double rate );
+    double maxReplotRate() const;
+
+    bool isReplotPending() const;
+    void flushReplot();
+
+    uint replotCount() const;
+    uint mergedReplotCount() const;
+    void resetReplotStatistics();
+
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
+    void invalidateLayerCache();
+
     // Layout
 
     void setPlotLayout( QwtPlotLayout * );
@@ -287,6 +384,7 @@ protected:
     static bool axisValid( int axisId );
 
     virtual void resizeEvent( QResizeEvent *e );
+    virtual void timerEvent( QTimerEvent * );
 
 private Q_SLOTS:
     void updateLegendItems( const QVariant &itemInfo,
@@ -295,6 +393,14 @@ private Q_SLOTS:
 private:
     friend class QwtPlotItem;
     void attachItem( QwtPlotItem *, bool );
+    void scheduleReplot();
+    void invalidateLayer( const QwtPlotItem * );
+
+    void drawLayers( QPainter *, const QRectF &,
+        const QwtScaleMap maps[axisCnt] );
+
+    void drawItemList( QPainter *, const QwtPlotItemList &, 
+        const QRectF &, const QwtScaleMap maps[axisCnt] ) const;
 
     void initAxesData();
     void deleteAxesData();
@@ -309,4 +415,6 @@ private:
     PrivateData *d_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlot::PaintAttributes )
+
 #endif
@@ -28,6 +28,9 @@ public:
 
     bool isValid;
 
+    // the interval, that has been autoscaled last time
+    QwtInterval autoScaleInterval;
+
     QwtScaleDiv scaleDiv;
     QwtScaleEngine *scaleEngine;
     QwtScaleWidget *scaleWidget;
@@ -133,6 +136,10 @@ QwtScaleWidget *QwtPlot::axisWidget( int axisId )
 /*!
   Change the scale engine for an axis
 
+  Passing the engine, that is already assigned, invalidates the
+  scale division, so that modifications of the engine are applied
+  with the next replot.
+
   \param axisId Axis index
   \param scaleEngine Scale engine
 
@@ -144,8 +151,11 @@ void QwtPlot::setAxisScaleEngine( int axisId, QwtScaleEngine *scaleEngine )
     {
         AxisData &d = *d_axisData[axisId];
 
-        delete d.scaleEngine;
-        d.scaleEngine = scaleEngine;
+        if ( scaleEngine != d.scaleEngine )
+        {
+            delete d.scaleEngine;
+            d.scaleEngine = scaleEngine;
+        }
 
         d_axisData[axisId]->scaleWidget->setTransformation( 
             scaleEngine->transformation() );
@@ -425,6 +435,7 @@ void QwtPlot::setAxisAutoScale( int axisId, bool on )
     if ( axisValid( axisId ) && ( d_axisData[axisId]->doAutoScale != on ) )
     {
         d_axisData[axisId]->doAutoScale = on;
+        d_axisData[axisId]->autoScaleInterval = QwtInterval();
         autoRefresh();
     }
 }
@@ -452,6 +463,7 @@ void QwtPlot::setAxisScale( int axisId, double min, double max, double stepSize
 
         d.doAutoScale = false;
         d.isValid = false;
+        d.autoScaleInterval = QwtInterval();
 
         d.minValue = min;
         d.maxValue = max;
@@ -482,6 +494,7 @@ void QwtPlot::setAxisScaleDiv( int axisId, const QwtScaleDiv &scaleDiv )
         d.doAutoScale = false;
         d.scaleDiv = scaleDiv;
         d.isValid = true;
+        d.autoScaleInterval = QwtInterval();
 
         autoRefresh();
     }
@@ -634,8 +647,14 @@ void QwtPlot::setAxisTitle( int axisId, const QwtText &title )
 
   updateAxes() is usually called by replot(). 
 
-  \sa setAxisAutoScale(), setAxisScale(), setAxisScaleDiv(), replot()
-      QwtPlotItem::boundingRect()
+  Items with QwtPlotItem::BoundingRectCache enabled avoid
+  recalculating their bounding rectangles for each replot.
+  When ScaleDivCache is enabled the scale division of an autoscaled
+  axis is only recalculated, when the bounding interval of the items
+  has changed or any setting of the axis has been modified.
+
+  \sa ScaleDivCache, setAxisAutoScale(), setAxisScale(), setAxisScaleDiv(), replot()
+      QwtPlotItem::boundingRect(), QwtPlotItem::autoScaleRect()
  */
 void QwtPlot::updateAxes()
 {
@@ -659,7 +678,7 @@ void QwtPlot::updateAxes()
 
         if ( axisAutoScale( item->xAxis() ) || axisAutoScale( item->yAxis() ) )
         {
-            const QRectF rect = item->boundingRect();
+            const QRectF rect = item->autoScaleRect();
 
             if ( rect.width() >= 0.0 )
                 intv[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
@@ -681,13 +700,21 @@ void QwtPlot::updateAxes()
 
         if ( d.doAutoScale && intv[axisId].isValid() )
         {
-            d.isValid = false;
+            // with ScaleDivCache the scale division needs to be recalculated
+            // only, when the bounding interval of the items has changed
+
+            if ( !d.isValid || intv[axisId] != d.autoScaleInterval
+                || !testPaintAttribute( ScaleDivCache ) )
+            {
+                d.isValid = false;
+                d.autoScaleInterval = intv[axisId];
 
-            minValue = intv[axisId].minValue();
-            maxValue = intv[axisId].maxValue();
+                minValue = intv[axisId].minValue();
+                maxValue = intv[axisId].maxValue();
 
-            d.scaleEngine->autoScale( d.maxMajor,
-                minValue, maxValue, stepSize );
+                d.scaleEngine->autoScale( d.maxMajor,
+                    minValue, maxValue, stepSize );
+            }
         }
         if ( !d.isValid )
         {
@@ -11,12 +11,15 @@
 #include "qwt_scale_map.h"
 #include "qwt_column_symbol.h"
 #include "qwt_painter.h"
+#include "qwt_math.h"
 #include <qpainter.h>
+#include <qpalette.h>
 
 class QwtPlotBarChart::PrivateData
 {
 public:
     PrivateData():
+        paintAttributes( 0 ),
         symbol( NULL ),
         legendMode( QwtPlotBarChart::LegendChartTitle )
     {
@@ -27,6 +30,8 @@ public:
         delete symbol;
     }
 
+    QwtPlotBarChart::PaintAttributes paintAttributes;
+
     QwtColumnSymbol *symbol;
     QwtPlotBarChart::LegendMode legendMode;
 };
@@ -69,6 +74,30 @@ int QwtPlotBarChart::rtti() const
     return QwtPlotItem::Rtti_PlotBarChart;
 }
 
+/*!
+  Specify an attribute how to draw the bar chart
+
+  \param attribute Paint attribute
+  \param on On/Off
+  \sa PaintAttribute, testPaintAttribute()
+*/
+void QwtPlotBarChart::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        d_data->paintAttributes |= attribute;
+    else
+        d_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa PaintAttribute, setPaintAttribute()
+*/
+bool QwtPlotBarChart::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( d_data->paintAttributes & attribute );
+}
+
 /*!
   Initialize data with an array of points
 
@@ -213,7 +242,7 @@ QRectF QwtPlotBarChart::boundingRect() const
   \param to Index of the last point to be painted. If to < 0 the
          curve will be painted to its last point.
 
-  \sa drawSymbols()
+  \sa drawSymbols(), MergeBars
 */
 void QwtPlotBarChart::drawSeries( QPainter *painter,
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
@@ -234,10 +263,57 @@ void QwtPlotBarChart::drawSeries( QPainter *painter,
 
     painter->save();
 
-    for ( int i = from; i <= to; i++ )
+    const QwtColumnSymbol *symbol = d_data->symbol;
+
+    const bool doMerge = ( d_data->paintAttributes & MergeBars ) &&
+        !( symbol && symbol->style() == QwtColumnSymbol::NoStyle );
+
+    if ( doMerge )
+    {
+        QwtColumnMerger merger( orientation() );
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QPointF sample = this->sample( i );
+
+            const QwtColumnRect barRect = columnRect( xMap, yMap,
+                canvasRect, interval, sample );
+
+            if ( !merger.append( barRect ) )
+            {
+                drawSample( painter, xMap, yMap,
+                    canvasRect, interval, i, sample );
+            }
+        }
+
+        // the frame color of the default symbol
+        QColor color = QPalette( Qt::gray ).color( QPalette::Dark );
+
+        if ( symbol )
+        {
+            const bool hasDarkFrame = symbol->lineWidth() > 0 &&
+                symbol->frameStyle() == QwtColumnSymbol::Plain;
+
+            color = symbol->palette().color(
+                hasDarkFrame ? QPalette::Dark : QPalette::Window );
+        }
+
+        /*
+          A bar, that is narrower than a pixel is
+          displayed as a line in the color of its frame
+         */
+        painter->setPen( QPen( color, 0.0 ) );
+        painter->setBrush( color );
+
+        merger.draw( painter );
+    }
+    else
     {
-        drawSample( painter, xMap, yMap,
-                    canvasRect, interval, i, sample( i ) );
+        for ( int i = from; i <= to; i++ )
+        {
+            drawSample( painter, xMap, yMap,
+                        canvasRect, interval, i, sample( i ) );
+        }
     }
 
     painter->restore();
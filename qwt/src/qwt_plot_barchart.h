@@ -67,6 +67,28 @@ public:
         LegendBarTitles
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        \sa setPaintAttribute(), testPaintAttribute()
+    */
+    enum PaintAttribute
+    {
+        /*!
+          Bars, that are narrower than a pixel and fall into the same
+          pixel, are merged into one rectangle covering all of them.
+          The merged rectangles are painted with one call of
+          QwtPainter::drawRects() in the color of the default symbol.
+
+          Only bars, that are at least one pixel wide are painted
+          by drawSample(). specialSymbol() is not called
+          for merged bars.
+         */
+        MergeBars = 0x01
+    };
+
+    //! Paint attributes
+    typedef QFlags<PaintAttribute> PaintAttributes;
+
     explicit QwtPlotBarChart( const QString &title = QString::null );
     explicit QwtPlotBarChart( const QwtText &title );
 
@@ -74,6 +96,9 @@ public:
 
     virtual int rtti() const;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setSamples( const QVector<QPointF> & );
     void setSamples( const QVector<double> & );
     void setSamples( QwtSeriesData<QPointF> *series );
@@ -120,4 +145,6 @@ private:
     PrivateData *d_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotBarChart::PaintAttributes )
+
 #endif
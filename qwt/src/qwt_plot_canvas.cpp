@@ -187,6 +187,26 @@ void QwtPlotCanvas::invalidateBackingStore()
         *d_data->backingStore = QPixmap();
 }
 
+/*!
+  \brief Replace the content of the backing store
+
+  This is useful, when the content of the canvas can be composed
+  from content, that has already been rendered - f.e. by
+  QwtPlotPanner. The canvas is not repainted.
+
+  \param pixmap Content of the canvas including its background
+                and frame. When the size of the pixmap doesn't match
+                the canvas it will be ignored by the next paint event.
+
+  \note The pixmap is ignored, when BackingStore is disabled
+  \sa backingStore(), invalidateBackingStore()
+*/
+void QwtPlotCanvas::setBackingStore( const QPixmap &pixmap )
+{
+    if ( d_data->backingStore )
+        *d_data->backingStore = pixmap;
+}
+
 /*!
   Qt event handler for QEvent::PolishRequest and QEvent::StyleChange
 
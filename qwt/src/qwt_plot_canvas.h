@@ -133,6 +133,7 @@ public:
 
     const QPixmap *backingStore() const;
     Q_INVOKABLE void invalidateBackingStore();
+    void setBackingStore( const QPixmap & );
 
     virtual bool event( QEvent * );
 
@@ -13,12 +13,16 @@
 #include "qwt_clipper.h"
 #include "qwt_painter.h"
 #include "qwt_scale_map.h"
+#include "qwt_scale_map_p.h"
 #include "qwt_plot.h"
 #include "qwt_spline_curve_fitter.h"
+#include "qwt_weeding_curve_fitter.h"
 #include "qwt_symbol.h"
 #include "qwt_point_mapper.h"
 #include <qpainter.h>
+#include <qpaintengine.h>
 #include <qpixmap.h>
+#include <qimage.h>
 #include <qalgorithms.h>
 #include <qmath.h>
 
@@ -61,6 +65,22 @@ static void qwtUpdateLegendIconSize( QwtPlotCurve *curve )
     }
 }
 
+static inline bool qwtCanDrawIncremental( const QPainter *painter )
+{
+    if ( painter->paintEngine()->type() != QPaintEngine::Raster )
+        return false;
+
+    return painter->transform().type() <= QTransform::TxTranslate;
+}
+
+static inline bool qwtIsCanvasGeometry(
+    const QwtPlot *plot, const QRectF &canvasRect )
+{
+    // exports or the overscan of the panner have other geometries
+    const QWidget *canvas = plot ? plot->canvas() : NULL;
+    return canvas && QRectF( canvas->contentsRect() ) == canvasRect;
+}
+
 static int qwtVerifyRange( int size, int &i1, int &i2 )
 {
     if ( size < 1 )
@@ -75,6 +95,46 @@ static int qwtVerifyRange( int size, int &i1, int &i2 )
     return ( i2 - i1 + 1 );
 }
 
+namespace
+{
+    class IncrementalCache
+    {
+    public:
+        IncrementalCache():
+            numPainted( 0 ),
+            pixelRatio( 1.0 ),
+            style( 0 ),
+            symbol( NULL )
+        {
+        }
+
+        void reset()
+        {
+            image = QImage();
+            numPainted = 0;
+        }
+
+        QImage image;
+
+        // the number of samples, that have been painted to the image
+        size_t numPainted;
+        QPointF lastSample;
+
+        // what needs to be unchanged for appending to the image
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QRectF canvasRect;
+        qreal pixelRatio;
+        QPainter::RenderHints renderHints;
+
+        int style;
+        QPen pen;
+        const QwtSymbol *symbol;
+        int attributes;
+        int paintAttributes;
+    };
+}
+
 class QwtPlotCurve::PrivateData
 {
 public:
@@ -110,6 +170,8 @@ public:
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    IncrementalCache incrementalCache;
 };
 
 /*!
@@ -169,6 +231,9 @@ void QwtPlotCurve::setPaintAttribute( PaintAttribute attribute, bool on )
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    if ( !testPaintAttribute( IncrementalDrawing ) )
+        d_data->incrementalCache.reset();
 }
 
 /*!
@@ -371,7 +436,25 @@ void QwtPlotCurve::drawSeries( QPainter *painter,
         return;
 
     if ( to < 0 )
+    {
+        /*
+            The image is shared between all draws of the curve. It
+            is used only for draws on the canvas, what happens in the
+            GUI thread, so that other draws don't discard it.
+         */
+        if ( from == 0 && testPaintAttribute( IncrementalDrawing )
+            && !testItemAttribute( QwtPlotItem::ThreadSafeRendering )
+            && d_data->brush.style() == Qt::NoBrush
+            && !testCurveAttribute( Fitted )
+            && qwtCanDrawIncremental( painter )
+            && qwtIsCanvasGeometry( plot(), canvasRect ) )
+        {
+            drawIncremental( painter, xMap, yMap, canvasRect );
+            return;
+        }
+
         to = numSamples - 1;
+    }
 
     if ( qwtVerifyRange( numSamples, from, to ) > 0 )
     {
@@ -398,6 +481,117 @@ void QwtPlotCurve::drawSeries( QPainter *painter,
     }
 }
 
+/*!
+  \brief Draw the complete curve using an image, where only
+         appended samples are painted
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rectangle of the canvas
+
+  \sa IncrementalDrawing, drawSeries()
+*/
+void QwtPlotCurve::drawIncremental( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect ) const
+{
+    IncrementalCache &cache = d_data->incrementalCache;
+
+    const size_t numSamples = dataSize();
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+
+    bool isValid = !cache.image.isNull()
+        && cache.numPainted > 0 && cache.numPainted <= numSamples
+        && cache.canvasRect == canvasRect
+        && cache.pixelRatio == pixelRatio
+        && cache.renderHints == painter->renderHints()
+        && cache.style == d_data->style
+        && cache.pen == d_data->pen
+        && cache.symbol == d_data->symbol
+        && cache.attributes == int( d_data->attributes )
+        && cache.paintAttributes == int( d_data->paintAttributes )
+        && qwtIsSameMap( cache.xMap, xMap )
+        && qwtIsSameMap( cache.yMap, yMap );
+
+    if ( isValid )
+    {
+        // a cheap check for samples, that have been replaced
+        isValid = sample( cache.numPainted - 1 ) == cache.lastSample;
+    }
+
+    int from = 0;
+
+    if ( isValid )
+        from = static_cast<int>( cache.numPainted );
+    else
+    {
+        const QSize size( qCeil( canvasRect.width() * pixelRatio ),
+            qCeil( canvasRect.height() * pixelRatio ) );
+
+        cache.image = QImage( size, QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+        cache.image.setDevicePixelRatio( pixelRatio );
+#endif
+        cache.image.fill( 0 );
+
+        cache.numPainted = 0;
+        cache.xMap = xMap;
+        cache.yMap = yMap;
+        cache.canvasRect = canvasRect;
+        cache.pixelRatio = pixelRatio;
+        cache.renderHints = painter->renderHints();
+        cache.style = d_data->style;
+        cache.pen = d_data->pen;
+        cache.symbol = d_data->symbol;
+        cache.attributes = d_data->attributes;
+        cache.paintAttributes = d_data->paintAttributes;
+    }
+
+    if ( numSamples > cache.numPainted && !cache.image.isNull() )
+    {
+        const int to = static_cast<int>( numSamples ) - 1;
+
+        QPainter imagePainter( &cache.image );
+        imagePainter.setRenderHints( painter->renderHints() );
+        imagePainter.translate( -canvasRect.topLeft() );
+
+        int lineFrom = from;
+        if ( from > 0 && d_data->style != Sticks && d_data->style != Dots )
+        {
+            // starting with the last painted sample for
+            // connecting the appended samples
+
+            lineFrom = from - 1;
+        }
+
+        imagePainter.save();
+        imagePainter.setPen( d_data->pen );
+        drawCurve( &imagePainter, d_data->style,
+            xMap, yMap, canvasRect, lineFrom, to );
+        imagePainter.restore();
+
+        if ( d_data->symbol &&
+            ( d_data->symbol->style() != QwtSymbol::NoSymbol ) )
+        {
+            // painting the last painted symbol again would blend it
+            // twice, so the connecting line ends on top of it
+
+            imagePainter.save();
+            drawSymbols( &imagePainter, *d_data->symbol,
+                xMap, yMap, canvasRect, from, to );
+            imagePainter.restore();
+        }
+
+        imagePainter.end();
+
+        cache.numPainted = numSamples;
+        cache.lastSample = sample( to );
+    }
+
+    painter->drawImage( canvasRect.topLeft(), cache.image );
+}
+
 /*!
   \brief Draw the line part (without symbols) of a curve interval.
   \param painter Painter
@@ -511,6 +705,18 @@ void QwtPlotCurve::drawLines( QPainter *painter,
 
     mapper.setBoundingRect( canvasRect );
 
+    // For PDF/SVG the polyline is reduced to what is visible
+    // at the vector resolution of QwtPainter
+
+    const double pixelSize = 
+        doAlign ? 0.0 : QwtPainter::vectorPixelSize( painter );
+
+    if ( pixelSize > 0.0 && !doFit )
+    {
+        mapper.setFlag( QwtPointMapper::WeedOutPoints, true );
+        mapper.setResolution( pixelSize );
+    }
+
     if ( doIntegers )
     {
         QPolygon polyline = mapper.toPolygon( 
@@ -528,6 +734,12 @@ void QwtPlotCurve::drawLines( QPainter *painter,
     {
         QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
 
+        if ( mapper.resolution() > 0.0 )
+        {
+            QwtWeedingCurveFitter fitter( 0.5 * mapper.resolution() );
+            polyline = fitter.fitCurve( polyline );
+        }
+
         if ( doFill )
         {
             if ( doFit )
@@ -672,6 +884,7 @@ void QwtPlotCurve::drawDots( QPainter *painter,
     QwtPointMapper mapper;
     mapper.setBoundingRect( canvasRect );
     mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
+    mapper.setResolution( QwtPainter::vectorPixelSize( painter ) );
 
     if ( d_data->paintAttributes & FilterPoints )
     {
@@ -1006,6 +1219,13 @@ void QwtPlotCurve::drawSymbols( QPainter *painter, const QwtSymbol &symbol,
     const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
     mapper.setBoundingRect( clipRect );
 
+    const double pixelSize = QwtPainter::vectorPixelSize( painter );
+    if ( pixelSize > 0.0 )
+    {
+        mapper.setFlag( QwtPointMapper::WeedOutPoints, true );
+        mapper.setResolution( pixelSize );
+    }
+
     const int chunkSize = 500;
 
     for ( int i = from; i <= to; i += chunkSize )
@@ -1189,6 +1409,45 @@ void QwtPlotCurve::setSamples( const QVector<QPointF> &samples )
     setData( new QwtPointSeriesData( samples ) );
 }
 
+/*!
+  \brief Notify the curve about samples, that have been appended
+
+  When samples are appended to the series, the bounding rectangle
+  of the new samples is united with the cached bounding rectangle
+  of the curve ( see QwtPlotItem::expandBoundingRect() ) and the
+  plot is updated. As the other samples are not scanned again
+  this is the counterpart of IncrementalDrawing for autoscaling.
+
+  Without QwtPlotItem::BoundingRectCache the plot is updated
+  like by itemChanged().
+
+  \param numSamples Number of samples, that have been appended
+                    at the end of the series
+
+  \sa IncrementalDrawing, QwtPlotItem::BoundingRectCache,
+      QwtPlot::ScaleDivCache
+*/
+void QwtPlotCurve::samplesAppended( int numSamples )
+{
+    const int size = static_cast<int>( dataSize() );
+    if ( numSamples <= 0 || size <= 0 )
+        return;
+
+    const int from = qMax( size - numSamples, 0 );
+    expandBoundingRect( qwtBoundingRect( *data(), from, size - 1 ) );
+}
+
+/*!
+  \brief Invalidate the image, that is used for IncrementalDrawing
+
+  \sa IncrementalDrawing
+ */
+void QwtPlotCurve::dataChanged()
+{
+    d_data->incrementalCache.reset();
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
   Assign a series of points
 
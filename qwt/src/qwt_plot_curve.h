@@ -229,6 +229,36 @@ public:
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+          Optimization for curves, where samples are appended only.
+
+          The curve is rendered into an image, that is kept together
+          with the number of painted samples, the scale maps and the
+          geometry of the canvas. When nothing else than the number
+          of samples has changed, only the appended samples are painted
+          into the image. The line connecting them starts at the last
+          painted sample and is painted on top of its symbol.
+          Otherwise the image is rendered from scratch.
+
+          Has only an effect, when the complete curve is drawn to a raster
+          device ( f.e. all widgets on screen ) by a painter, that is not
+          scaled or rotated, for the geometry of the canvas. Curves with
+          a brush or the Fitted attribute are always drawn completely -
+          like exports to other geometries.
+
+          IncrementalDrawing can't be combined with
+          QwtPlotItem::ThreadSafeRendering: as the image is not locked
+          against concurrent draws, it is ignored for thread safe curves.
+
+          \note Samples must not be modified or removed without
+                calling dataChanged() - what happens when assigning samples
+                with setSamples(). Modifying the symbol without calling
+                setSymbol() is not detected.
+
+          \sa samplesAppended()
+         */
+        IncrementalDrawing = 0x20
     };
 
     //! Paint attributes
@@ -255,6 +285,8 @@ public:
     void setSamples( const QVector<QPointF> & );
     void setSamples( QwtSeriesData<QPointF> * );
 
+    void samplesAppended( int numSamples );
+
     virtual int closestPoint( const QPoint &pos, double *dist = NULL ) const;
 
     double minXValue() const;
@@ -325,7 +357,13 @@ protected:
     void closePolyline( QPainter *,
         const QwtScaleMap &, const QwtScaleMap &, QPolygonF & ) const;
 
+    virtual void dataChanged();
+
 private:
+    void drawIncremental( QPainter *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
@@ -12,6 +12,7 @@
 #include "qwt_painter.h"
 #include "qwt_column_symbol.h"
 #include "qwt_scale_map.h"
+#include "qwt_math.h"
 #include <qstring.h>
 #include <qpainter.h>
 
@@ -37,6 +38,7 @@ class QwtPlotHistogram::PrivateData
 {
 public:
     PrivateData():
+        paintAttributes( 0 ),
         baseline( 0.0 ),
         style( Columns ),
         symbol( NULL )
@@ -48,6 +50,7 @@ public:
         delete symbol;
     }
 
+    QwtPlotHistogram::PaintAttributes paintAttributes;
     double baseline;
 
     QPen pen;
@@ -94,6 +97,30 @@ void QwtPlotHistogram::init()
     setZ( 20.0 );
 }
 
+/*!
+  Specify an attribute how to draw the histogram
+
+  \param attribute Paint attribute
+  \param on On/Off
+  \sa PaintAttribute, testPaintAttribute()
+*/
+void QwtPlotHistogram::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        d_data->paintAttributes |= attribute;
+    else
+        d_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa PaintAttribute, setPaintAttribute()
+*/
+bool QwtPlotHistogram::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( d_data->paintAttributes & attribute );
+}
+
 /*!
   Set the histogram's drawing style
 
@@ -453,7 +480,7 @@ void QwtPlotHistogram::drawOutline( QPainter *painter,
   \param to Index of the last sample to be painted. If to < 0 the
          histogram will be painted to its last point.
 
-  \sa setStyle(), style(), setSymbol(), drawColumn()
+  \sa setStyle(), style(), setSymbol(), drawColumn(), MergeColumns
 */
 void QwtPlotHistogram::drawColumns( QPainter *painter,
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
@@ -462,6 +489,12 @@ void QwtPlotHistogram::drawColumns( QPainter *painter,
     painter->setPen( d_data->pen );
     painter->setBrush( d_data->brush );
 
+    const bool doMerge = ( d_data->paintAttributes & MergeColumns ) &&
+        !( d_data->symbol &&
+            ( d_data->symbol->style() != QwtColumnSymbol::NoStyle ) );
+
+    QwtColumnMerger merger( orientation() );
+
     const QwtSeriesData<QwtIntervalSample> *series = data();
 
     for ( int i = from; i <= to; i++ )
@@ -470,9 +503,18 @@ void QwtPlotHistogram::drawColumns( QPainter *painter,
         if ( !sample.interval.isNull() )
         {
             const QwtColumnRect rect = columnRect( sample, xMap, yMap );
-            drawColumn( painter, rect, sample );
+            if ( !( doMerge && merger.append( rect ) ) )
+                drawColumn( painter, rect, sample );
         }
     }
+
+    if ( doMerge )
+    {
+        painter->setPen( d_data->pen );
+        painter->setBrush( d_data->brush );
+
+        merger.draw( painter );
+    }
 }
 
 /*!
@@ -76,12 +76,37 @@ public:
         UserStyle = 100
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        \sa setPaintAttribute(), testPaintAttribute()
+    */
+    enum PaintAttribute
+    {
+        /*!
+           In Columns style all columns, that are narrower than a pixel
+           and fall into the same pixel, are merged into one rectangle
+           covering all of them. The merged rectangles are painted
+           with one call of QwtPainter::drawRects() using pen() and brush().
+
+           Only columns, that are at least one pixel wide are
+           painted by drawColumn(). MergeColumns is ignored,
+           when a symbol() has been assigned.
+         */
+        MergeColumns = 0x01
+    };
+
+    //! Paint attributes
+    typedef QFlags<PaintAttribute> PaintAttributes;
+
     explicit QwtPlotHistogram( const QString &title = QString::null );
     explicit QwtPlotHistogram( const QwtText &title );
     virtual ~QwtPlotHistogram();
 
     virtual int rtti() const;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setPen( const QColor &, qreal width = 0.0, Qt::PenStyle = Qt::SolidLine );
     void setPen( const QPen & );
     const QPen &pen() const;
@@ -136,4 +161,6 @@ private:
     PrivateData *d_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotHistogram::PaintAttributes )
+
 #endif
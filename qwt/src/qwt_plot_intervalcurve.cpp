@@ -42,6 +42,40 @@ static inline bool qwtIsVSampleInside( const QwtIntervalSample &sample,
     return !isOffScreen;
 }
 
+static QVector<QwtIntervalSample> qwtWeedOutIntervals(
+    const QwtSeriesData<QwtIntervalSample> *series,
+    const QwtScaleMap &map, int from, int to )
+{
+    QVector<QwtIntervalSample> samples;
+
+    int pixel = 0;
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtIntervalSample s = series->sample( i );
+
+        const int pos = qRound( map.transform( s.value ) );
+        if ( !samples.isEmpty() && pos == pixel )
+        {
+            // the envelope of all intervals in the same pixel
+
+            QwtInterval &interval = samples.last().interval;
+
+            if ( s.interval.minValue() < interval.minValue() )
+                interval.setMinValue( s.interval.minValue() );
+
+            if ( s.interval.maxValue() > interval.maxValue() )
+                interval.setMaxValue( s.interval.maxValue() );
+        }
+        else
+        {
+            samples += s;
+            pixel = pos;
+        }
+    }
+
+    return samples;
+}
+
 class QwtPlotIntervalCurve::PrivateData
 {
 public:
@@ -374,7 +408,16 @@ void QwtPlotIntervalCurve::drawTube( QPainter *painter,
 
     painter->save();
 
-    const size_t size = to - from + 1;
+    const bool doWeedOut = d_data->paintAttributes & WeedOutIntermediateIntervals;
+
+    QVector<QwtIntervalSample> weededSamples;
+    if ( doWeedOut )
+    {
+        weededSamples = qwtWeedOutIntervals( data(),
+            ( orientation() == Qt::Vertical ) ? xMap : yMap, from, to );
+    }
+
+    const size_t size = doWeedOut ? weededSamples.size() : to - from + 1;
     QPolygonF polygon( 2 * size );
     QPointF *points = polygon.data();
 
@@ -383,7 +426,8 @@ void QwtPlotIntervalCurve::drawTube( QPainter *painter,
         QPointF &minValue = points[i];
         QPointF &maxValue = points[2 * size - 1 - i];
 
-        const QwtIntervalSample intervalSample = sample( from + i );
+        const QwtIntervalSample intervalSample =
+            doWeedOut ? weededSamples[i] : sample( from + i );
         if ( orientation() == Qt::Vertical )
         {
             double x = xMap.transform( intervalSample.value );
@@ -505,10 +549,24 @@ void QwtPlotIntervalCurve::drawSymbols(
     const double yMax = tr.bottom();
 
     const bool doClip = d_data->paintAttributes & ClipSymbol;
+    const bool doWeedOut = d_data->paintAttributes & WeedOutIntermediateIntervals;
+
+    QVector<QwtIntervalSample> weededSamples;
+    if ( doWeedOut )
+    {
+        weededSamples = qwtWeedOutIntervals( data(),
+            ( orientation() == Qt::Vertical ) ? xMap : yMap, from, to );
+
+        // one symbol for each pixel position, displaying
+        // the envelope of all symbols at this position
+
+        from = 0;
+        to = weededSamples.size() - 1;
+    }
 
     for ( int i = from; i <= to; i++ )
     {
-        const QwtIntervalSample s = sample( i );
+        const QwtIntervalSample s = doWeedOut ? weededSamples[i] : sample( i );
 
         if ( orientation() == Qt::Vertical )
         {
@@ -70,7 +70,20 @@ public:
         ClipPolygons = 0x01,
 
         //! Check if a symbol is on the plot canvas before painting it.
-        ClipSymbol   = 0x02
+        ClipSymbol   = 0x02,
+
+        /*!
+          Samples, that are mapped to the same pixel position, are
+          reduced to one interval from the minimum of their lower
+          to the maximum of their upper limits. The tube and the symbols
+          are built from these intervals, so that the effort for painting
+          depends on the size of the canvas and not on the number of samples.
+
+          Like QwtPointMapper::WeedOutIntermediatePoints this is an
+          optimization for series with many samples per pixel. The samples
+          are expected to be ordered by their value.
+         */
+        WeedOutIntermediateIntervals = 0x04
     };
 
     //! Paint attributes
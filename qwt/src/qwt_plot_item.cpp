@@ -25,6 +25,7 @@ public:
         interests( 0 ),
         renderHints( 0 ),
         renderThreadCount( 1 ),
+        isBoundingRectValid( false ),
         z( 0.0 ),
         xAxis( QwtPlot::xBottom ),
         yAxis( QwtPlot::yLeft ),
@@ -42,6 +43,9 @@ public:
     QwtPlotItem::RenderHints renderHints;
     uint renderThreadCount;
 
+    bool isBoundingRectValid;
+    QRectF boundingRect;
+
     double z;
 
     int xAxis;
@@ -443,14 +447,20 @@ bool QwtPlotItem::isVisible() const
 
 /*!
    Update the legend and call QwtPlot::autoRefresh() for the
-   parent plot.
+   parent plot. When QwtPlot::LayerCache is enabled the cached
+   layer of the item is invalidated.
 
    \sa QwtPlot::legendChanged(), QwtPlot::autoRefresh()
 */
 void QwtPlotItem::itemChanged()
 {
+    d_data->isBoundingRectValid = false;
+
     if ( d_data->plot )
+    {
+        d_data->plot->invalidateLayer( this );
         d_data->plot->autoRefresh();
+    }
 }
 
 /*!
@@ -539,6 +549,113 @@ QRectF QwtPlotItem::boundingRect() const
     return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
 }
 
+/*!
+   \brief Bounding rectangle used for autoscaling
+
+   When BoundingRectCache is enabled the result of boundingRect()
+   is cached until itemChanged() or invalidateBoundingRect() is called.
+   Otherwise autoScaleRect() is the same as boundingRect().
+
+   \return Bounding rectangle of the item
+   \sa expandBoundingRect(), QwtPlot::updateAxes()
+*/
+QRectF QwtPlotItem::autoScaleRect() const
+{
+    if ( !( d_data->attributes & BoundingRectCache ) )
+        return boundingRect();
+
+    if ( !d_data->isBoundingRectValid )
+    {
+        d_data->boundingRect = boundingRect();
+        d_data->isBoundingRectValid = true;
+    }
+
+    return d_data->boundingRect;
+}
+
+/*!
+   \brief Extend the cached bounding rectangle
+
+   Items with data, that is growing ( f.e. by appending samples )
+   can report the bounding rectangle of the new part instead of
+   calling itemChanged(). The cached bounding rectangle is united
+   with rect and the plot is updated without scanning all samples
+   in the next QwtPlot::updateAxes().
+
+   Without BoundingRectCache expandBoundingRect() is the
+   same as itemChanged().
+
+   \param rect Bounding rectangle of the modified part of the item.
+               A width or height < 0.0 is ignored.
+
+   \sa autoScaleRect(), invalidateBoundingRect(), BoundingRectCache
+*/
+void QwtPlotItem::expandBoundingRect( const QRectF &rect )
+{
+    if ( !( d_data->attributes & BoundingRectCache ) 
+        || !d_data->isBoundingRectValid )
+    {
+        itemChanged();
+        return;
+    }
+
+    QRectF &br = d_data->boundingRect;
+
+    if ( rect.width() >= 0.0 )
+    {
+        if ( br.width() >= 0.0 )
+        {
+            const double left = qMin( br.left(), rect.left() );
+            const double right = qMax( br.right(), rect.right() );
+
+            br.setLeft( left );
+            br.setRight( right );
+        }
+        else
+        {
+            br.setLeft( rect.left() );
+            br.setRight( rect.right() );
+        }
+    }
+
+    if ( rect.height() >= 0.0 )
+    {
+        if ( br.height() >= 0.0 )
+        {
+            const double top = qMin( br.top(), rect.top() );
+            const double bottom = qMax( br.bottom(), rect.bottom() );
+
+            br.setTop( top );
+            br.setBottom( bottom );
+        }
+        else
+        {
+            br.setTop( rect.top() );
+            br.setBottom( rect.bottom() );
+        }
+    }
+
+    if ( d_data->plot )
+    {
+        d_data->plot->invalidateLayer( this );
+        d_data->plot->autoRefresh();
+    }
+}
+
+/*!
+   \brief Invalidate the cached bounding rectangle
+
+   The bounding rectangle will be recalculated by boundingRect()
+   in the next call of autoScaleRect(). In opposite to itemChanged()
+   the plot is not updated.
+
+   \sa autoScaleRect(), BoundingRectCache
+*/
+void QwtPlotItem::invalidateBoundingRect()
+{
+    d_data->isBoundingRectValid = false;
+}
+
 /*!
    \brief Calculate a hint for the canvas margin
 
@@ -156,7 +156,42 @@ public:
            its bounding rectangle. 
            \sa getCanvasMarginHint()
          */
-        Margins = 0x04
+        Margins = 0x04,
+
+        /*!
+           The item is updated frequently. When QwtPlot::LayerCache
+           is enabled dynamic items are painted for each replot, while
+           all other items are cached in layers.
+           \sa QwtPlot::LayerCache
+         */
+        Dynamic = 0x08,
+
+        /*!
+           draw() can be called from a thread different from the
+           GUI thread. When QwtPlot::ParallelRendering is enabled
+           the item is rendered concurrently to other items.
+
+           An item is thread safe, when draw() does not modify
+           any state, that is shared with other items or with the
+           plot widget and does not use any classes, that are restricted
+           to the GUI thread like QPixmap. F.e. QwtSymbol::Cache
+           has to be disabled for curves with symbols.
+
+           \sa QwtPlot::ParallelRendering
+         */
+        ThreadSafeRendering = 0x10,
+
+        /*!
+           The boundingRect() is cached for the autoscaling calculation.
+           The cache is invalidated by itemChanged() and extended by
+           expandBoundingRect(), so that items with growing data
+           don't need to be scanned completely for each replot.
+           F.e. QwtPlotCurve::samplesAppended() extends the cache
+           by the bounding rectangle of the appended samples.
+
+           \sa autoScaleRect(), expandBoundingRect(), QwtPlot::updateAxes()
+         */
+        BoundingRectCache = 0x20
     };
 
     //! Plot Item Attributes
@@ -268,6 +303,10 @@ public:
 
     virtual QRectF boundingRect() const;
 
+    QRectF autoScaleRect() const;
+    void expandBoundingRect( const QRectF & );
+    void invalidateBoundingRect();
+
     virtual void getCanvasMarginHint( 
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasSize,
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include "qwt_plot_layout.h"
+#include "qwt_plot_scene.h"
 #include "qwt_text.h"
 #include "qwt_text_label.h"
 #include "qwt_scale_widget.h"
@@ -19,6 +20,9 @@ class QwtPlotLayout::LayoutData
 {
 public:
     void init( const QwtPlot *, const QRectF &rect );
+    void init( const QwtPlotScene &, const QRectF &rect );
+
+    bool operator==( const LayoutData & ) const;
 
     struct t_legendData
     {
@@ -43,7 +47,7 @@ public:
     struct t_scaleData
     {
         bool isEnabled;
-        const QwtScaleWidget *scaleWidget;
+        QwtText title;
         QFont scaleFont;
         int start;
         int end;
@@ -84,6 +88,13 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
 
         legend.hint = QSize( w, h );
     }
+    else
+    {
+        legend.frameWidth = 0;
+        legend.hScrollExtent = 0;
+        legend.vScrollExtent = 0;
+        legend.hint = QSize();
+    }
 
     // title
 
@@ -125,7 +136,12 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
 
             scale[axis].isEnabled = true;
 
-            scale[axis].scaleWidget = scaleWidget;
+            scale[axis].title = scaleWidget->title();
+            if ( !( scale[axis].title.testPaintAttribute(
+                QwtText::PaintUsingTextFont ) ) )
+            {
+                scale[axis].title.setFont( scaleWidget->font() );
+            }
 
             scale[axis].scaleFont = scaleWidget->font();
 
@@ -153,6 +169,7 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
         else
         {
             scale[axis].isEnabled = false;
+            scale[axis].title = QwtText();
             scale[axis].start = 0;
             scale[axis].end = 0;
             scale[axis].baseLineOffset = 0;
@@ -170,12 +187,191 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
         &canvas.contentsMargins[ QwtPlot::xBottom ] );
 }
 
+/*
+  Extract all layout relevant data from a scene, that has
+  no legend and a canvas without frame
+*/
+void QwtPlotLayout::LayoutData::init(
+    const QwtPlotScene &scene, const QRectF & )
+{
+    // legend
+
+    legend.frameWidth = 0;
+    legend.hScrollExtent = 0;
+    legend.vScrollExtent = 0;
+    legend.hint = QSize();
+
+    // title
+
+    title.frameWidth = 0;
+    title.text = scene.title();
+    if ( !( title.text.testPaintAttribute( QwtText::PaintUsingTextFont ) ) )
+        title.text.setFont( scene.font() );
+
+    // footer
+
+    footer.frameWidth = 0;
+    footer.text = scene.footer();
+    if ( !( footer.text.testPaintAttribute( QwtText::PaintUsingTextFont ) ) )
+        footer.text.setFont( scene.font() );
+
+    // scales
+
+    for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+    {
+        const QwtScaleDraw *scaleDraw = scene.axisScaleDraw( axis );
+
+        if ( scene.axisEnabled( axis ) && scaleDraw )
+        {
+            const int margin = scene.axisMargin( axis );
+
+            scale[axis].isEnabled = true;
+
+            scale[axis].title = scene.axisTitle( axis );
+            if ( !( scale[axis].title.testPaintAttribute(
+                QwtText::PaintUsingTextFont ) ) )
+            {
+                scale[axis].title.setFont( scene.font() );
+            }
+
+            scale[axis].scaleFont = scene.axisFont( axis );
+
+            scaleDraw->getBorderDistHint( scale[axis].scaleFont,
+                scale[axis].start, scale[axis].end );
+
+            scale[axis].baseLineOffset = margin;
+            scale[axis].tickOffset = margin;
+            if ( scaleDraw->hasComponent( QwtAbstractScaleDraw::Ticks ) )
+                scale[axis].tickOffset += scaleDraw->maxTickLength();
+
+            scale[axis].dimWithoutTitle = margin + 1
+                + qCeil( scaleDraw->extent( scale[axis].scaleFont ) );
+
+            if ( !scale[axis].title.isEmpty() )
+                scale[axis].dimWithoutTitle += scene.axisSpacing( axis );
+        }
+        else
+        {
+            scale[axis].isEnabled = false;
+            scale[axis].title = QwtText();
+            scale[axis].start = 0;
+            scale[axis].end = 0;
+            scale[axis].baseLineOffset = 0;
+            scale[axis].tickOffset = 0.0;
+            scale[axis].dimWithoutTitle = 0;
+        }
+    }
+
+    // canvas
+
+    for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+        canvas.contentsMargins[axis] = 0;
+}
+
+/*
+  Compare all layout relevant data. When nothing has changed
+  since the previous layout, the geometries can be kept.
+*/
+bool QwtPlotLayout::LayoutData::operator==( const LayoutData &other ) const
+{
+    if ( legend.frameWidth != other.legend.frameWidth
+        || legend.hScrollExtent != other.legend.hScrollExtent
+        || legend.vScrollExtent != other.legend.vScrollExtent
+        || legend.hint != other.legend.hint )
+    {
+        return false;
+    }
+
+    if ( title.frameWidth != other.title.frameWidth
+        || title.text != other.title.text )
+    {
+        return false;
+    }
+
+    if ( footer.frameWidth != other.footer.frameWidth
+        || footer.text != other.footer.text )
+    {
+        return false;
+    }
+
+    for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+    {
+        const t_scaleData &sd1 = scale[axis];
+        const t_scaleData &sd2 = other.scale[axis];
+
+        if ( sd1.isEnabled != sd2.isEnabled )
+            return false;
+
+        if ( sd1.isEnabled )
+        {
+            if ( sd1.title != sd2.title
+                || sd1.scaleFont != sd2.scaleFont
+                || sd1.start != sd2.start
+                || sd1.end != sd2.end
+                || sd1.baseLineOffset != sd2.baseLineOffset
+                || sd1.tickOffset != sd2.tickOffset
+                || sd1.dimWithoutTitle != sd2.dimWithoutTitle )
+            {
+                return false;
+            }
+        }
+
+        if ( canvas.contentsMargins[axis] != other.canvas.contentsMargins[axis] )
+            return false;
+    }
+
+    return true;
+}
+
 class QwtPlotLayout::PrivateData
 {
 public:
+    enum { NumRects = 4 + QwtPlot::axisCnt };
+
     PrivateData():
-        spacing( 5 )
+        spacing( 5 ),
+        changedRects( 0xff ),
+        hasValidInputs( false ),
+        hasLegend( false )
+    {
+    }
+
+    void getRects( QRectF rects[NumRects] ) const
     {
+        rects[0] = titleRect;
+        rects[1] = footerRect;
+        rects[2] = legendRect;
+        rects[3] = canvasRect;
+
+        for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+            rects[4 + axis] = scaleRect[axis];
+    }
+
+    bool isUnchanged( const QwtPlotLayout::LayoutData &data,
+        const QRectF &rect, QwtPlotLayout::Options options, bool legend ) const
+    {
+        return hasValidInputs && hasLegend == legend
+            && plotRect == rect && layoutOptions == options
+            && layoutData == data;
+    }
+
+    void finishLayout( const QRectF &rect, QwtPlotLayout::Options options,
+        bool legend, const QRectF oldRects[NumRects] )
+    {
+        QRectF rects[NumRects];
+        getRects( rects );
+
+        changedRects = 0;
+        for ( int i = 0; i < NumRects; i++ )
+        {
+            if ( rects[i] != oldRects[i] )
+                changedRects |= static_cast<QwtPlotLayout::LayoutRect>( 1 << i );
+        }
+
+        plotRect = rect;
+        layoutOptions = options;
+        hasLegend = legend;
+        hasValidInputs = true;
     }
 
     QRectF titleRect;
@@ -191,6 +387,14 @@ public:
     unsigned int spacing;
     unsigned int canvasMargin[QwtPlot::axisCnt];
     bool alignCanvasToScales[QwtPlot::axisCnt];
+
+    QwtPlotLayout::LayoutRects changedRects;
+
+    // the input of the previous layout
+    bool hasValidInputs;
+    bool hasLegend;
+    QRectF plotRect;
+    QwtPlotLayout::Options layoutOptions;
 };
 
 /*!
@@ -239,6 +443,8 @@ void QwtPlotLayout::setCanvasMargin( int margin, int axis )
     }
     else if ( axis >= 0 && axis < QwtPlot::axisCnt )
         d_data->canvasMargin[axis] = margin;
+
+    d_data->hasValidInputs = false;
 }
 
 /*!
@@ -264,6 +470,8 @@ void QwtPlotLayout::setAlignCanvasToScales( bool on )
 {
     for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
         d_data->alignCanvasToScales[axis] = on;
+
+    d_data->hasValidInputs = false;
 }
 
 /*!
@@ -287,6 +495,8 @@ void QwtPlotLayout::setAlignCanvasToScale( int axisId, bool on )
 {
     if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
         d_data->alignCanvasToScales[axisId] = on;
+
+    d_data->hasValidInputs = false;
 }
 
 /*!
@@ -316,6 +526,7 @@ bool QwtPlotLayout::alignCanvasToScale( int axisId ) const
 void QwtPlotLayout::setSpacing( int spacing )
 {
     d_data->spacing = qMax( 0, spacing );
+    d_data->hasValidInputs = false;
 }
 
 /*!
@@ -364,6 +575,8 @@ void QwtPlotLayout::setLegendPosition( QwtPlot::LegendPosition pos, double ratio
         default:
             break;
     }
+
+    d_data->hasValidInputs = false;
 }
 
 /*!
@@ -422,7 +635,11 @@ double QwtPlotLayout::legendRatio() const
  */
 void QwtPlotLayout::setTitleRect( const QRectF &rect )
 {
-    d_data->titleRect = rect;
+    if ( d_data->titleRect != rect )
+    {
+        d_data->titleRect = rect;
+        d_data->changedRects |= TitleRect;
+    }
 }
 
 /*!
@@ -444,7 +661,11 @@ QRectF QwtPlotLayout::titleRect() const
  */
 void QwtPlotLayout::setFooterRect( const QRectF &rect )
 {
-    d_data->footerRect = rect;
+    if ( d_data->footerRect != rect )
+    {
+        d_data->footerRect = rect;
+        d_data->changedRects |= FooterRect;
+    }
 }
 
 /*!
@@ -468,7 +689,11 @@ QRectF QwtPlotLayout::footerRect() const
  */
 void QwtPlotLayout::setLegendRect( const QRectF &rect )
 {
-    d_data->legendRect = rect;
+    if ( d_data->legendRect != rect )
+    {
+        d_data->legendRect = rect;
+        d_data->changedRects |= LegendRect;
+    }
 }
 
 /*!
@@ -494,7 +719,14 @@ QRectF QwtPlotLayout::legendRect() const
 void QwtPlotLayout::setScaleRect( int axis, const QRectF &rect )
 {
     if ( axis >= 0 && axis < QwtPlot::axisCnt )
-        d_data->scaleRect[axis] = rect;
+    {
+        if ( d_data->scaleRect[axis] != rect )
+        {
+            d_data->scaleRect[axis] = rect;
+            d_data->changedRects |=
+                static_cast<LayoutRect>( YLeftScaleRect << axis );
+        }
+    }
 }
 
 /*!
@@ -522,7 +754,11 @@ QRectF QwtPlotLayout::scaleRect( int axis ) const
  */
 void QwtPlotLayout::setCanvasRect( const QRectF &rect )
 {
-    d_data->canvasRect = rect;
+    if ( d_data->canvasRect != rect )
+    {
+        d_data->canvasRect = rect;
+        d_data->changedRects |= CanvasRect;
+    }
 }
 
 /*!
@@ -534,8 +770,30 @@ QRectF QwtPlotLayout::canvasRect() const
     return d_data->canvasRect;
 }
 
+/*!
+  \brief Geometries, that have been changed by the last call of activate()
+
+  When all layout relevant parameters are the same as for the
+  previous call of activate() the calculation is skipped and
+  changedRects() returns 0. Otherwise a rectangle is reported
+  as changed, when it differs from its previous geometry.
+
+  The scale rectangles are indicated by YLeftScaleRect << axisId.
+
+  \return Changed rectangles
+  \sa activate(), invalidate()
+*/
+QwtPlotLayout::LayoutRects QwtPlotLayout::changedRects() const
+{
+    return d_data->changedRects;
+}
+
 /*!
   Invalidate the geometry of all components.
+
+  The next call of activate() will recalculate the layout, even if
+  none of its parameters has been changed.
+
   \sa activate()
 */
 void QwtPlotLayout::invalidate()
@@ -545,6 +803,9 @@ void QwtPlotLayout::invalidate()
 
     for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
         d_data->scaleRect[axis] = QRect();
+
+    d_data->changedRects = LayoutRects( 0xff );
+    d_data->hasValidInputs = false;
 }
 
 /*!
@@ -977,9 +1238,9 @@ void QwtPlotLayout::expandLineBreaks( Options options, const QRectF &rect,
                 }
 
                 int d = scaleData.dimWithoutTitle;
-                if ( !scaleData.scaleWidget->title().isEmpty() )
+                if ( !scaleData.title.isEmpty() )
                 {
-                    d += scaleData.scaleWidget->titleHeightForWidth( qFloor( length ) );
+                    d += qCeil( scaleData.title.heightForWidth( qFloor( length ) ) );
                 }
 
 
@@ -1260,27 +1521,47 @@ void QwtPlotLayout::alignScales( Options options,
 /*!
   \brief Recalculate the geometry of all components.
 
+  All layout relevant parameters - like the extents of the scales,
+  the texts of title and footer, the size hint of the legend or
+  the contents margins of the canvas - are collected from the plot
+  widgets. When they are the same as for the previous call, the
+  geometries are not recalculated.
+
   \param plot Plot to be layout
   \param plotRect Rectangle where to place the components
   \param options Layout options
 
-  \sa invalidate(), titleRect(), footerRect()
+  \sa invalidate(), changedRects(), titleRect(), footerRect()
       legendRect(), scaleRect(), canvasRect()
 */
 void QwtPlotLayout::activate( const QwtPlot *plot,
     const QRectF &plotRect, Options options )
 {
-    invalidate();
+    // We extract all layout relevant parameters from the widgets,
+    // and compare them with those of the previous layout
 
-    QRectF rect( plotRect );  // undistributed rest of the plot rect
+    LayoutData layoutData;
+    layoutData.init( plot, plotRect );
 
-    // We extract all layout relevant parameters from the widgets,
-    // and save them to d_data->layoutData.
+    const bool hasLegend = !( options & IgnoreLegend )
+        && plot->legend() && !plot->legend()->isEmpty();
 
-    d_data->layoutData.init( plot, rect );
+    if ( d_data->isUnchanged( layoutData, plotRect, options, hasLegend ) )
+    {
+        d_data->changedRects = 0;
+        return;
+    }
 
-    if ( !( options & IgnoreLegend )
-        && plot->legend() && !plot->legend()->isEmpty() )
+    QRectF oldRects[PrivateData::NumRects];
+    d_data->getRects( oldRects );
+
+    invalidate();
+
+    d_data->layoutData = layoutData;
+
+    QRectF rect( plotRect );  // undistributed rest of the plot rect
+
+    if ( hasLegend )
     {
         d_data->legendRect = layoutLegend( options, rect );
 
@@ -1306,6 +1587,55 @@ void QwtPlotLayout::activate( const QwtPlot *plot,
         }
     }
 
+    layoutComponents( options, rect );
+
+    d_data->finishLayout( plotRect, options, hasLegend, oldRects );
+}
+
+/*!
+  \brief Recalculate the geometry of all components of a scene
+
+  The layout is calculated like for a plot widget, but from the
+  settings of the scene. As a scene has no legend and its canvas
+  has no frame, IgnoreLegend and IgnoreFrames are always implied.
+
+  \param scene Scene to be layout
+  \param plotRect Rectangle where to place the components
+  \param options Layout options
+
+  \sa QwtPlotScene, QwtPlotRenderer::renderScene()
+*/
+void QwtPlotLayout::activateScene( const QwtPlotScene &scene,
+    const QRectF &plotRect, Options options )
+{
+    LayoutData layoutData;
+    layoutData.init( scene, plotRect );
+
+    if ( d_data->isUnchanged( layoutData, plotRect, options, false ) )
+    {
+        d_data->changedRects = 0;
+        return;
+    }
+
+    QRectF oldRects[PrivateData::NumRects];
+    d_data->getRects( oldRects );
+
+    invalidate();
+
+    d_data->layoutData = layoutData;
+    layoutComponents( options | IgnoreLegend | IgnoreFrames, plotRect );
+
+    d_data->finishLayout( plotRect, options, false, oldRects );
+}
+
+/*
+  Distribute rect between title, footer, axes and canvas
+  from the data in d_data->layoutData
+*/
+void QwtPlotLayout::layoutComponents( Options options, const QRectF &plotRect )
+{
+    QRectF rect( plotRect );
+
     /*
      +---+-----------+---+
      |       Title       |
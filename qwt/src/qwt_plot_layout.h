@@ -13,6 +13,8 @@
 #include "qwt_global.h"
 #include "qwt_plot.h"
 
+class QwtPlotScene;
+
 /*!
   \brief Layout engine for QwtPlot.
 
@@ -57,6 +59,40 @@ public:
     //! Layout options
     typedef QFlags<Option> Options;
 
+    /*!
+      Rectangles of the layout
+      \sa changedRects()
+     */
+    enum LayoutRect
+    {
+        //! titleRect()
+        TitleRect = 0x01,
+
+        //! footerRect()
+        FooterRect = 0x02,
+
+        //! legendRect()
+        LegendRect = 0x04,
+
+        //! canvasRect()
+        CanvasRect = 0x08,
+
+        //! scaleRect( QwtPlot::yLeft )
+        YLeftScaleRect = 0x10,
+
+        //! scaleRect( QwtPlot::yRight )
+        YRightScaleRect = 0x20,
+
+        //! scaleRect( QwtPlot::xBottom )
+        XBottomScaleRect = 0x40,
+
+        //! scaleRect( QwtPlot::xTop )
+        XTopScaleRect = 0x80
+    };
+
+    //! Layout rectangles
+    typedef QFlags<LayoutRect> LayoutRects;
+
     explicit QwtPlotLayout();
     virtual ~QwtPlotLayout();
 
@@ -83,6 +119,9 @@ public:
     virtual void activate( const QwtPlot *,
         const QRectF &rect, Options options = 0x00 );
 
+    virtual void activateScene( const QwtPlotScene &,
+        const QRectF &rect, Options options = 0x00 );
+
     virtual void invalidate();
 
     QRectF titleRect() const;
@@ -91,6 +130,8 @@ public:
     QRectF scaleRect( int axis ) const;
     QRectF canvasRect() const;
 
+    LayoutRects changedRects() const;
+
     class LayoutData;
 
 protected:
@@ -114,10 +155,13 @@ protected:
 private:
     Q_DISABLE_COPY(QwtPlotLayout)
 
+    void layoutComponents( Options, const QRectF & );
+
     class PrivateData;
     PrivateData *d_data;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotLayout::Options )
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotLayout::LayoutRects )
 
 #endif
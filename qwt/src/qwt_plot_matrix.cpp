@@ -0,0 +1,811 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_matrix.h"
+#include "qwt_plot_layout.h"
+#include "qwt_plot_item.h"
+#include "qwt_scale_engine.h"
+#include "qwt_scale_div.h"
+#include "qwt_interval.h"
+#include <qvector.h>
+#include <qlist.h>
+#include <qevent.h>
+#include <qapplication.h>
+#include <qmath.h>
+
+static inline bool qwtIsXAxis( int axisId )
+{
+    return axisId == QwtPlot::xBottom || axisId == QwtPlot::xTop;
+}
+
+static void qwtCopyLayoutSettings(
+    const QwtPlotLayout *from, QwtPlotLayout *to )
+{
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        to->setCanvasMargin( from->canvasMargin( axisId ), axisId );
+        to->setAlignCanvasToScale( axisId, from->alignCanvasToScale( axisId ) );
+    }
+
+    to->setSpacing( from->spacing() );
+    to->setLegendPosition( from->legendPosition(), from->legendRatio() );
+}
+
+static void qwtReplotCanvas( QwtPlot *plot )
+{
+    /*
+      Like in QwtPlot::replot() the layout requests, that have been
+      posted because of changed axes labels, need to be processed
+      before painting to avoid that scales and canvas get out of sync.
+     */
+    QApplication::sendPostedEvents( plot, QEvent::LayoutRequest );
+
+    QWidget *canvas = plot->canvas();
+    if ( canvas == NULL )
+        return;
+
+    const bool ok = QMetaObject::invokeMethod(
+        canvas, "replot", Qt::DirectConnection );
+    if ( !ok )
+    {
+        // fallback, when canvas has no a replot method
+        canvas->update( canvas->contentsRect() );
+    }
+}
+
+class QwtPlotMatrix::AxisData
+{
+public:
+    AxisData():
+        doAutoScale( true ),
+        minValue( 0.0 ),
+        maxValue( 1000.0 ),
+        stepSize( 0.0 ),
+        isValid( false )
+    {
+    }
+
+    bool doAutoScale;
+
+    double minValue;
+    double maxValue;
+    double stepSize;
+
+    bool isValid;
+
+    QwtScaleDiv scaleDiv;
+    QwtInterval autoScaleInterval;
+};
+
+class QwtPlotMatrix::PrivateData
+{
+public:
+    PrivateData():
+        numRows( 0 ),
+        numColumns( 0 ),
+        spacing( 5 ),
+        isLayoutDirty( true ),
+        replotTimerId( 0 )
+    {
+        isAxisEnabled[QwtPlot::yLeft] = true;
+        isAxisEnabled[QwtPlot::yRight] = false;
+        isAxisEnabled[QwtPlot::xBottom] = true;
+        isAxisEnabled[QwtPlot::xTop] = false;
+    }
+
+    QwtPlot *plotAt( int row, int column ) const
+    {
+        if ( row < 0 || row >= numRows || column < 0 || column >= numColumns )
+            return NULL;
+
+        return plots[ row * numColumns + column ];
+    }
+
+    QwtPlotMatrix::AxisData *axisDataAt( int axisId, int rowOrColumn )
+    {
+        if ( axisId < 0 || axisId >= QwtPlot::axisCnt )
+            return NULL;
+
+        if ( rowOrColumn < 0 || rowOrColumn >= axisData[axisId].size() )
+            return NULL;
+
+        return &axisData[axisId][rowOrColumn];
+    }
+
+    // the plots of a column for the x axes, of a row for the y axes
+    QList<QwtPlot *> axisPlots( int axisId, int rowOrColumn ) const
+    {
+        QList<QwtPlot *> axisPlots;
+
+        if ( qwtIsXAxis( axisId ) )
+        {
+            for ( int row = 0; row < numRows; row++ )
+                axisPlots += plotAt( row, rowOrColumn );
+        }
+        else
+        {
+            for ( int col = 0; col < numColumns; col++ )
+                axisPlots += plotAt( rowOrColumn, col );
+        }
+
+        return axisPlots;
+    }
+
+    int numRows;
+    int numColumns;
+    QVector<QwtPlot *> plots;
+
+    int spacing;
+    bool isAxisEnabled[QwtPlot::axisCnt];
+    QVector<QwtPlotMatrix::AxisData> axisData[QwtPlot::axisCnt];
+
+    bool isLayoutDirty;
+    int replotTimerId;
+};
+
+static QSize qwtMatrixSizeHint( const QwtPlotMatrix *matrix, bool minimum )
+{
+    int w = 0;
+    for ( int col = 0; col < matrix->numColumns(); col++ )
+    {
+        int colWidth = 0;
+        for ( int row = 0; row < matrix->numRows(); row++ )
+        {
+            const QwtPlot *plot = matrix->plotAt( row, col );
+            const QSize hint = minimum
+                ? plot->minimumSizeHint() : plot->sizeHint();
+
+            colWidth = qMax( colWidth, hint.width() );
+        }
+
+        w += colWidth;
+    }
+
+    int h = 0;
+    for ( int row = 0; row < matrix->numRows(); row++ )
+    {
+        int rowHeight = 0;
+        for ( int col = 0; col < matrix->numColumns(); col++ )
+        {
+            const QwtPlot *plot = matrix->plotAt( row, col );
+            const QSize hint = minimum
+                ? plot->minimumSizeHint() : plot->sizeHint();
+
+            rowHeight = qMax( rowHeight, hint.height() );
+        }
+
+        h += rowHeight;
+    }
+
+    w += qMax( matrix->numColumns() - 1, 0 ) * matrix->spacing();
+    h += qMax( matrix->numRows() - 1, 0 ) * matrix->spacing();
+
+    const QRect cr = matrix->contentsRect();
+    w += matrix->width() - cr.width();
+    h += matrix->height() - cr.height();
+
+    return QSize( w, h );
+}
+
+/*!
+  \brief Constructor
+
+  Creates numRows x numColumns plots. The yLeft and xBottom axes
+  are enabled and autoscaled.
+
+  \param numRows Number of rows
+  \param numColumns Number of columns
+  \param parent Parent widget
+ */
+QwtPlotMatrix::QwtPlotMatrix( int numRows, int numColumns, QWidget *parent ):
+    QFrame( parent )
+{
+    d_data = new PrivateData;
+
+    d_data->numRows = qMax( numRows, 0 );
+    d_data->numColumns = qMax( numColumns, 0 );
+
+    d_data->plots.resize( d_data->numRows * d_data->numColumns );
+    for ( int i = 0; i < d_data->plots.size(); i++ )
+        d_data->plots[i] = new QwtPlot( this );
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        d_data->axisData[axisId].resize( qwtIsXAxis( axisId )
+            ? d_data->numColumns : d_data->numRows );
+    }
+
+    updateLayout();
+}
+
+//! Destructor
+QwtPlotMatrix::~QwtPlotMatrix()
+{
+    delete d_data;
+}
+
+//! \return Number of rows
+int QwtPlotMatrix::numRows() const
+{
+    return d_data->numRows;
+}
+
+//! \return Number of columns
+int QwtPlotMatrix::numColumns() const
+{
+    return d_data->numColumns;
+}
+
+/*!
+  \param row Row index
+  \param column Column index
+  \return Plot at a position of the matrix, or NULL for invalid indexes
+ */
+QwtPlot *QwtPlotMatrix::plotAt( int row, int column )
+{
+    return d_data->plotAt( row, column );
+}
+
+/*!
+  \param row Row index
+  \param column Column index
+  \return Plot at a position of the matrix, or NULL for invalid indexes
+ */
+const QwtPlot *QwtPlotMatrix::plotAt( int row, int column ) const
+{
+    return d_data->plotAt( row, column );
+}
+
+/*!
+  \brief Change the spacing between the plots
+
+  \param spacing Spacing
+  \sa spacing()
+ */
+void QwtPlotMatrix::setSpacing( int spacing )
+{
+    spacing = qMax( spacing, 0 );
+    if ( spacing != d_data->spacing )
+    {
+        d_data->spacing = spacing;
+        updateLayout();
+    }
+}
+
+/*!
+  \return Spacing between the plots
+  \sa setSpacing()
+ */
+int QwtPlotMatrix::spacing() const
+{
+    return d_data->spacing;
+}
+
+/*!
+  \brief Enable or disable an axis
+
+  An enabled axis is shown at the corresponding border of the matrix.
+
+  \param axisId Axis index
+  \param on On/Off
+  \sa axisEnabled()
+ */
+void QwtPlotMatrix::enableAxis( int axisId, bool on )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+    {
+        if ( on != d_data->isAxisEnabled[axisId] )
+        {
+            d_data->isAxisEnabled[axisId] = on;
+            updateLayout();
+        }
+    }
+}
+
+/*!
+  \param axisId Axis index
+  \return True, when the axis is enabled
+  \sa enableAxis()
+ */
+bool QwtPlotMatrix::axisEnabled( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->isAxisEnabled[axisId];
+
+    return false;
+}
+
+/*!
+  \brief Enable autoscaling for the axis of a row or column
+
+  \param axisId Axis index
+  \param rowOrColumn Column for the x axes, row for the y axes
+  \param on On/Off
+
+  \sa axisAutoScale(), setAxisScale(), setAxisScaleDiv(), updateAxes()
+ */
+void QwtPlotMatrix::setAxisAutoScale( int axisId, int rowOrColumn, bool on )
+{
+    AxisData *d = d_data->axisDataAt( axisId, rowOrColumn );
+    if ( d && d->doAutoScale != on )
+    {
+        d->doAutoScale = on;
+        d->isValid = false;
+        d->autoScaleInterval = QwtInterval();
+    }
+}
+
+/*!
+  \param axisId Axis index
+  \param rowOrColumn Column for the x axes, row for the y axes
+  \return True, when autoscaling is enabled
+  \sa setAxisAutoScale()
+ */
+bool QwtPlotMatrix::axisAutoScale( int axisId, int rowOrColumn ) const
+{
+    const AxisData *d = d_data->axisDataAt( axisId, rowOrColumn );
+    if ( d )
+        return d->doAutoScale;
+
+    return false;
+}
+
+/*!
+  \brief Disable autoscaling and specify a fixed scale for
+         the axis of a row or column
+
+  The scale division is calculated by the scale engine of
+  the first plot of the row or column.
+
+  \param axisId Axis index
+  \param rowOrColumn Column for the x axes, row for the y axes
+  \param min Minimum of the scale
+  \param max Maximum of the scale
+  \param stepSize Major step size. If <code>step == 0</code>, the step size is
+                  calculated automatically using the maxMajor setting.
+
+  \sa setAxisScaleDiv(), setAxisAutoScale(), QwtPlot::setAxisScale()
+ */
+void QwtPlotMatrix::setAxisScale( int axisId, int rowOrColumn,
+    double min, double max, double stepSize )
+{
+    AxisData *d = d_data->axisDataAt( axisId, rowOrColumn );
+    if ( d )
+    {
+        d->doAutoScale = false;
+        d->isValid = false;
+        d->autoScaleInterval = QwtInterval();
+
+        d->minValue = min;
+        d->maxValue = max;
+        d->stepSize = stepSize;
+    }
+}
+
+/*!
+  \brief Disable autoscaling and assign a scale division to
+         the axis of a row or column
+
+  \param axisId Axis index
+  \param rowOrColumn Column for the x axes, row for the y axes
+  \param scaleDiv Scale division
+
+  \sa setAxisScale(), setAxisAutoScale(), QwtPlot::setAxisScaleDiv()
+ */
+void QwtPlotMatrix::setAxisScaleDiv( int axisId, int rowOrColumn,
+    const QwtScaleDiv &scaleDiv )
+{
+    AxisData *d = d_data->axisDataAt( axisId, rowOrColumn );
+    if ( d )
+    {
+        d->doAutoScale = false;
+        d->scaleDiv = scaleDiv;
+        d->isValid = true;
+        d->autoScaleInterval = QwtInterval();
+    }
+}
+
+/*!
+  \param axisId Axis index
+  \param rowOrColumn Column for the x axes, row for the y axes
+  \return Scale division of the row or column, as calculated
+          by the last updateAxes()
+ */
+QwtScaleDiv QwtPlotMatrix::axisScaleDiv( int axisId, int rowOrColumn ) const
+{
+    const AxisData *d = d_data->axisDataAt( axisId, rowOrColumn );
+    if ( d )
+        return d->scaleDiv;
+
+    return QwtScaleDiv();
+}
+
+/*!
+  \return True, when a replot has been scheduled, but not executed yet
+  \sa replot(), flushReplot()
+ */
+bool QwtPlotMatrix::isReplotPending() const
+{
+    return d_data->replotTimerId != 0;
+}
+
+/*!
+  \brief Schedule a replot of all plots
+
+  The replot is executed by flushReplot(), when the event loop
+  is processed the next time. All calls of replot() until then
+  are merged into one.
+
+  \sa flushReplot(), isReplotPending()
+ */
+void QwtPlotMatrix::replot()
+{
+    if ( d_data->replotTimerId == 0 )
+        d_data->replotTimerId = startTimer( 0 );
+}
+
+/*!
+  \brief Execute a pending replot immediately
+
+  The axes of all rows and columns are updated, the
+  plots are laid out - when the scales have been changed - and
+  the canvas of each plot is replotted. As the axes of the plots
+  have already been updated, QwtPlot::replot() is not called.
+
+  \note As QwtPlot::replot() is bypassed, the replots of the matrix
+        are not counted by QwtPlot::replotCount() and have no effect
+        on the rate limit of QwtPlot::setMaxReplotRate().
+
+  When no replot is pending, flushReplot() does nothing.
+
+  \sa replot(), updateAxes(), updateLayout()
+ */
+void QwtPlotMatrix::flushReplot()
+{
+    if ( d_data->replotTimerId == 0 )
+        return;
+
+    killTimer( d_data->replotTimerId );
+    d_data->replotTimerId = 0;
+
+    updateAxes();
+
+    if ( d_data->isLayoutDirty )
+        updateLayout();
+
+    for ( int i = 0; i < d_data->plots.size(); i++ )
+        qwtReplotCanvas( d_data->plots[i] );
+}
+
+/*!
+  \brief Calculate the scale divisions of all rows and columns
+
+  For autoscaled axes the bounding intervals of the items
+  of all plots in a row/column are united. The scale division is
+  calculated by the scale engine - using the maxMajor/maxMinor
+  settings - of the first plot in a row/column and assigned
+  to all plots of the row/column. When QwtPlot::ScaleDivCache is
+  enabled for the first plot, it is recalculated only, when
+  the bounding interval or the scale settings have changed.
+
+  \sa QwtPlot::updateAxes(), QwtPlotItem::autoScaleRect()
+ */
+void QwtPlotMatrix::updateAxes()
+{
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        const bool isXAxis = qwtIsXAxis( axisId );
+
+        QVector<AxisData> &axisData = d_data->axisData[axisId];
+        for ( int i = 0; i < axisData.size(); i++ )
+        {
+            AxisData &d = axisData[i];
+
+            const QList<QwtPlot *> plots = d_data->axisPlots( axisId, i );
+            if ( plots.isEmpty() )
+                continue;
+
+            const QwtPlot *firstPlot = plots.first();
+            const QwtScaleEngine *scaleEngine =
+                firstPlot->axisScaleEngine( axisId );
+
+            double minValue = d.minValue;
+            double maxValue = d.maxValue;
+            double stepSize = d.stepSize;
+
+            if ( d.doAutoScale )
+            {
+                QwtInterval intv;
+
+                for ( int j = 0; j < plots.size(); j++ )
+                {
+                    const QwtPlotItemList &itemList = plots[j]->itemList();
+                    for ( QwtPlotItemIterator it = itemList.begin();
+                        it != itemList.end(); ++it )
+                    {
+                        const QwtPlotItem *item = *it;
+
+                        if ( !item->testItemAttribute( QwtPlotItem::AutoScale ) )
+                            continue;
+
+                        if ( !item->isVisible() )
+                            continue;
+
+                        const QRectF rect = item->autoScaleRect();
+
+                        if ( isXAxis )
+                        {
+                            if ( item->xAxis() == axisId && rect.width() >= 0.0 )
+                                intv |= QwtInterval( rect.left(), rect.right() );
+                        }
+                        else
+                        {
+                            if ( item->yAxis() == axisId && rect.height() >= 0.0 )
+                                intv |= QwtInterval( rect.top(), rect.bottom() );
+                        }
+                    }
+                }
+
+                const bool doCache =
+                    firstPlot->testPaintAttribute( QwtPlot::ScaleDivCache );
+
+                if ( intv.isValid() && ( !d.isValid
+                    || intv != d.autoScaleInterval || !doCache ) )
+                {
+                    d.isValid = false;
+                    d.autoScaleInterval = intv;
+
+                    minValue = intv.minValue();
+                    maxValue = intv.maxValue();
+
+                    scaleEngine->autoScale( firstPlot->axisMaxMajor( axisId ),
+                        minValue, maxValue, stepSize );
+                }
+            }
+
+            if ( !d.isValid )
+            {
+                d.scaleDiv = scaleEngine->divideScale( minValue, maxValue,
+                    firstPlot->axisMaxMajor( axisId ),
+                    firstPlot->axisMaxMinor( axisId ), stepSize );
+
+                d.isValid = true;
+            }
+
+            for ( int j = 0; j < plots.size(); j++ )
+            {
+                QwtPlot *plot = plots[j];
+
+                if ( plot->axisAutoScale( axisId )
+                    || plot->axisScaleDiv( axisId ) != d.scaleDiv )
+                {
+                    plot->setAxisScaleDiv( axisId, d.scaleDiv );
+
+                    // the extents of the scales might have changed
+                    d_data->isLayoutDirty = true;
+                }
+            }
+        }
+    }
+
+    for ( int i = 0; i < d_data->plots.size(); i++ )
+        d_data->plots[i]->updateAxes();
+}
+
+/*!
+  \brief Calculate the geometries of all plots
+
+  The axes are enabled at the borders of the matrix only. Then
+  the distances between the borders of each plot and its canvas
+  are calculated by a layout with the settings of the layout
+  of the plot. From them the geometries are calculated in one pass,
+  so that all canvases have the same size and the canvases of a
+  row/column are aligned.
+
+  \note The layouts of the plots are not modified by the measurement.
+        So a layout, that is derived from QwtPlotLayout, is only used
+        for the final geometries.
+ */
+void QwtPlotMatrix::updateLayout()
+{
+    d_data->isLayoutDirty = false;
+
+    const int numRows = d_data->numRows;
+    const int numColumns = d_data->numColumns;
+
+    if ( numRows <= 0 || numColumns <= 0 )
+        return;
+
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            bool showAxis[QwtPlot::axisCnt];
+            showAxis[QwtPlot::yLeft] = ( col == 0 );
+            showAxis[QwtPlot::yRight] = ( col == numColumns - 1 );
+            showAxis[QwtPlot::xBottom] = ( row == numRows - 1 );
+            showAxis[QwtPlot::xTop] = ( row == 0 );
+
+            QwtPlot *plot = d_data->plotAt( row, col );
+            for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+            {
+                plot->enableAxis( axisId,
+                    showAxis[axisId] && d_data->isAxisEnabled[axisId] );
+            }
+        }
+    }
+
+    const QRect cr = contentsRect();
+    const int spacing = d_data->spacing;
+
+    const double cellWidth = qMax( 0.0,
+        double( cr.width() - ( numColumns - 1 ) * spacing ) / numColumns );
+    const double cellHeight = qMax( 0.0,
+        double( cr.height() - ( numRows - 1 ) * spacing ) / numRows );
+
+    // distances between the borders of the plots and their canvases
+
+    const int numPlots = d_data->plots.size();
+
+    QVector<int> left( numPlots );
+    QVector<int> top( numPlots );
+    QVector<int> right( numPlots );
+    QVector<int> bottom( numPlots );
+
+    for ( int i = 0; i < numPlots; i++ )
+    {
+        QwtPlot *plot = d_data->plots[i];
+
+        const QRect pr = plot->contentsRect();
+
+        const int fl = pr.left();
+        const int ft = pr.top();
+        const int fr = plot->width() - 1 - pr.right();
+        const int fb = plot->height() - 1 - pr.bottom();
+
+        const QRectF plotRect( fl, ft,
+            cellWidth - fl - fr, cellHeight - ft - fb );
+
+        // the layout of the plot is activated with the final geometry
+        QwtPlotLayout layout;
+        qwtCopyLayoutSettings( plot->plotLayout(), &layout );
+
+        layout.activate( plot, plotRect );
+
+        const QRectF canvasRect = layout.canvasRect();
+
+        left[i] = qCeil( canvasRect.left() );
+        top[i] = qCeil( canvasRect.top() );
+        right[i] = qCeil( cellWidth - canvasRect.right() );
+        bottom[i] = qCeil( cellHeight - canvasRect.bottom() );
+    }
+
+    QVector<int> columnLeft( numColumns, 0 );
+    QVector<int> columnRight( numColumns, 0 );
+    QVector<int> rowTop( numRows, 0 );
+    QVector<int> rowBottom( numRows, 0 );
+
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            const int i = row * numColumns + col;
+
+            columnLeft[col] = qMax( columnLeft[col], left[i] );
+            columnRight[col] = qMax( columnRight[col], right[i] );
+            rowTop[row] = qMax( rowTop[row], top[i] );
+            rowBottom[row] = qMax( rowBottom[row], bottom[i] );
+        }
+    }
+
+    int canvasWidth = cr.width() - ( numColumns - 1 ) * spacing;
+    for ( int col = 0; col < numColumns; col++ )
+        canvasWidth -= columnLeft[col] + columnRight[col];
+
+    canvasWidth = qMax( canvasWidth / numColumns, 0 );
+
+    int canvasHeight = cr.height() - ( numRows - 1 ) * spacing;
+    for ( int row = 0; row < numRows; row++ )
+        canvasHeight -= rowTop[row] + rowBottom[row];
+
+    canvasHeight = qMax( canvasHeight / numRows, 0 );
+
+    int y = cr.top();
+    for ( int row = 0; row < numRows; row++ )
+    {
+        int x = cr.left();
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            const int i = row * numColumns + col;
+
+            const QRect rect(
+                x + columnLeft[col] - left[i], y + rowTop[row] - top[i],
+                left[i] + canvasWidth + right[i],
+                top[i] + canvasHeight + bottom[i] );
+
+            QwtPlot *plot = d_data->plots[i];
+
+            // a resized plot updates its layout in its resizeEvent()
+            const bool isResized = ( rect.size() != plot->size() );
+
+            plot->setGeometry( rect );
+            if ( !isResized )
+                plot->updateLayout();
+
+            x += columnLeft[col] + canvasWidth + columnRight[col] + spacing;
+        }
+
+        y += rowTop[row] + canvasHeight + rowBottom[row] + spacing;
+    }
+}
+
+/*!
+  \return Size hint, calculated from the size hints of the plots
+  \sa minimumSizeHint()
+ */
+QSize QwtPlotMatrix::sizeHint() const
+{
+    return qwtMatrixSizeHint( this, false );
+}
+
+/*!
+  \return Minimum size hint, calculated from the minimum size hints of the plots
+  \sa sizeHint()
+ */
+QSize QwtPlotMatrix::minimumSizeHint() const
+{
+    return qwtMatrixSizeHint( this, true );
+}
+
+/*!
+  \brief Adds handling of layout requests
+  \param event Event
+
+  \return See QFrame::event()
+*/
+bool QwtPlotMatrix::event( QEvent *event )
+{
+    bool ok = QFrame::event( event );
+    switch ( event->type() )
+    {
+        case QEvent::LayoutRequest:
+            updateLayout();
+            break;
+        case QEvent::PolishRequest:
+            replot();
+            break;
+        default:;
+    }
+    return ok;
+}
+
+/*!
+  Recalculate the geometries of the plots
+  \param event Resize event
+ */
+void QwtPlotMatrix::resizeEvent( QResizeEvent *event )
+{
+    QFrame::resizeEvent( event );
+    updateLayout();
+}
+
+/*!
+  Executes a pending replot
+  \param event Timer event
+ */
+void QwtPlotMatrix::timerEvent( QTimerEvent *event )
+{
+    if ( event->timerId() == d_data->replotTimerId )
+    {
+        flushReplot();
+        return;
+    }
+
+    QFrame::timerEvent( event );
+}
@@ -0,0 +1,106 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_MATRIX_H
+#define QWT_PLOT_MATRIX_H
+
+#include "qwt_global.h"
+#include "qwt_plot.h"
+#include <qframe.h>
+
+class QwtScaleDiv;
+
+/*!
+  \brief A grid of plots with synchronized axes
+
+  QwtPlotMatrix arranges numRows() x numColumns() plots, where
+  the plots of a column share the scales of the x axes and the plots
+  of a row share the scales of the y axes. The scales are shown
+  at the borders of the matrix only: xBottom below the last row,
+  xTop above the first row, yLeft left of the first column
+  and yRight right of the last column.
+
+  The scales of the matrix are calculated by updateAxes() - and not
+  by the plots. In case of autoscaling the bounding rectangles of all
+  items of a row/column are united and the scale division is calculated
+  once by the scale engine of the first plot in the row/column.
+  The resulting QwtScaleDiv is assigned to all plots of the row/column.
+
+  The geometries of all plots are calculated in one pass by
+  updateLayout(). The plots are placed so that all canvases of a column
+  have the same horizontal and all canvases of a row have the same
+  vertical position.
+
+  replot() schedules a replot of the complete matrix, that is executed
+  by flushReplot() the next time the event loop is processed. So
+  many modifications result in one update of the axes, one
+  layout calculation and one replot of each plot.
+
+  \note The axes of the plots, their scale divisions and their
+        geometries are controlled by the matrix. Plots, that
+        contain items with the QwtPlotItem::ThreadSafeRendering
+        attribute, can render them in parallel by
+        enabling QwtPlot::ParallelRendering.
+*/
+class QWT_EXPORT QwtPlotMatrix: public QFrame
+{
+    Q_OBJECT
+
+public:
+    explicit QwtPlotMatrix( int numRows, int numColumns,
+        QWidget *parent = NULL );
+
+    virtual ~QwtPlotMatrix();
+
+    int numRows() const;
+    int numColumns() const;
+
+    QwtPlot *plotAt( int row, int column );
+    const QwtPlot *plotAt( int row, int column ) const;
+
+    void setSpacing( int );
+    int spacing() const;
+
+    void enableAxis( int axisId, bool on = true );
+    bool axisEnabled( int axisId ) const;
+
+    void setAxisAutoScale( int axisId, int rowOrColumn, bool on = true );
+    bool axisAutoScale( int axisId, int rowOrColumn ) const;
+
+    void setAxisScale( int axisId, int rowOrColumn,
+        double min, double max, double stepSize = 0 );
+
+    void setAxisScaleDiv( int axisId, int rowOrColumn, const QwtScaleDiv & );
+    QwtScaleDiv axisScaleDiv( int axisId, int rowOrColumn ) const;
+
+    bool isReplotPending() const;
+    void flushReplot();
+
+    virtual QSize sizeHint() const;
+    virtual QSize minimumSizeHint() const;
+
+    virtual bool event( QEvent * );
+
+public Q_SLOTS:
+    void replot();
+
+protected:
+    virtual void updateAxes();
+    virtual void updateLayout();
+
+    virtual void resizeEvent( QResizeEvent * );
+    virtual void timerEvent( QTimerEvent * );
+
+private:
+    class AxisData;
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
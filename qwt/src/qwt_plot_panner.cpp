@@ -10,10 +10,63 @@
 #include "qwt_plot_panner.h"
 #include "qwt_scale_div.h"
 #include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
+#include "qwt_plot_marker.h"
 #include "qwt_painter.h"
 #include <qbitmap.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
+#include <qapplication.h>
+#include <qevent.h>
+#if !defined(QT_NO_QFUTURE)
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+#endif
+
+#if !defined(QT_NO_QFUTURE)
+
+static inline void qwtDrawOverscanItem( QPainter *painter,
+    const QwtPlotItem *item, const QwtScaleMap maps[], const QRectF &rect )
+{
+    painter->save();
+
+    painter->setRenderHint( QPainter::Antialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+    painter->setRenderHint( QPainter::HighQualityAntialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+    item->draw( painter, maps[item->xAxis()], maps[item->yAxis()], rect );
+
+    painter->restore();
+}
+
+static QImage qwtOverscanImage( const QWidget *canvas, const QSize &size )
+{
+#if QT_VERSION >= 0x050000
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( canvas );
+
+    QImage image( size * pixelRatio, QImage::Format_ARGB32_Premultiplied );
+    image.setDevicePixelRatio( pixelRatio );
+#else
+    Q_UNUSED( canvas );
+    QImage image( size, QImage::Format_ARGB32_Premultiplied );
+#endif
+    image.fill( 0 );
+
+    return image;
+}
+
+static void qwtRenderOverscanItem( QImage *image,
+    const QwtPlotItem *item, const QwtScaleMap *maps, QRect rect )
+{
+    QPainter painter( image );
+    painter.translate( -rect.topLeft() );
+
+    qwtDrawOverscanItem( &painter, item, maps, rect );
+}
+
+#endif
 
 static QBitmap qwtBorderMask( const QWidget *canvas, const QSize &size )
 {
@@ -234,7 +287,126 @@ void QwtPlotPanner::moveCanvas( int dx, int dy )
     }
 
     plot->setAutoReplot( doAutoReplot );
-    plot->replot();
+
+    if ( !replotFromOverscan( dx, dy ) )
+        plot->replot();
+}
+
+/*!
+   \brief Check if the content of an item is moved with the scales
+
+   When all visible items are aligned to the scales the content of the
+   canvas after panning can be taken from the overscan, instead of
+   replotting the canvas.
+
+   The default implementation accepts all types of Qwt items, that
+   are positioned by the scale maps only. Grids, scale items,
+   legend items, text labels, markers with lines and items of
+   unknown type - rtti() >= QwtPlotItem::Rtti_PlotUserItem - are
+   not aligned, as they depend on the scale divisions or the
+   geometry of the canvas.
+
+   \param item Plot item
+   \return true, when the item is aligned to the scales
+
+   \sa QwtPanner::setOverscan(), moveCanvas()
+ */
+bool QwtPlotPanner::isScaleAligned( const QwtPlotItem *item ) const
+{
+    switch( item->rtti() )
+    {
+        case QwtPlotItem::Rtti_PlotCurve:
+        case QwtPlotItem::Rtti_PlotSpectroCurve:
+        case QwtPlotItem::Rtti_PlotIntervalCurve:
+        case QwtPlotItem::Rtti_PlotHistogram:
+        case QwtPlotItem::Rtti_PlotSpectrogram:
+        case QwtPlotItem::Rtti_PlotSVG:
+        case QwtPlotItem::Rtti_PlotTradingCurve:
+        case QwtPlotItem::Rtti_PlotShape:
+        case QwtPlotItem::Rtti_PlotZone:
+            return true;
+
+        case QwtPlotItem::Rtti_PlotMarker:
+        {
+            const QwtPlotMarker *marker =
+                static_cast<const QwtPlotMarker *>( item );
+
+            return marker->lineStyle() == QwtPlotMarker::NoLine;
+        }
+        default:
+            return false;
+    }
+}
+
+/*
+   Replot the axes and compose the canvas from the overscan,
+   that has been moved by dx/dy
+ */
+bool QwtPlotPanner::replotFromOverscan( int dx, int dy )
+{
+    QwtPlot *plt = plot();
+    QwtPlotCanvas *cv = qobject_cast<QwtPlotCanvas *>( canvas() );
+
+    if ( plt == NULL || cv == NULL ||
+        !cv->testPaintAttribute( QwtPlotCanvas::BackingStore ) ||
+        cv->testPaintAttribute( QwtPlotCanvas::OpenGLBuffer ) )
+    {
+        return false;
+    }
+
+    const QPixmap *backingStore = cv->backingStore();
+    if ( backingStore == NULL || backingStore->isNull() )
+        return false;
+
+    const QwtPlotItemList& itmList = plt->itemList();
+    for ( QwtPlotItemIterator it = itmList.begin();
+        it != itmList.end(); ++it )
+    {
+        const QwtPlotItem *item = *it;
+        if ( item && item->isVisible() && !isScaleAligned( item ) )
+            return false;
+    }
+
+    const QPixmap overscan = overscanPixmap();
+    const QRect rect = overscanRect().translated( dx, dy );
+
+    if ( overscan.isNull() || !rect.contains( cv->contentsRect() ) )
+        return false;
+
+    const QRect canvasGeometry = cv->geometry();
+
+    const bool doAutoReplot = plt->autoReplot();
+    plt->setAutoReplot( false );
+
+    plt->updateAxes();
+    QApplication::sendPostedEvents( plt, QEvent::LayoutRequest );
+
+    plt->setAutoReplot( doAutoReplot );
+
+    if ( cv->geometry() != canvasGeometry )
+    {
+        // the layout has changed with the tick labels
+        cv->replot();
+        return true;
+    }
+
+    QPixmap pm = *backingStore;
+
+    QPainter painter( &pm );
+
+    const QBitmap mask = contentsMask();
+    if ( mask.isNull() )
+        painter.setClipRect( cv->contentsRect() );
+    else
+        painter.setClipRegion( QRegion( mask ) );
+
+    painter.drawPixmap( rect, overscan );
+    painter.end();
+
+    cv->setBackingStore( pm );
+    cv->update( cv->contentsRect() );
+
+    return true;
 }
 
 /*!
@@ -273,3 +445,116 @@ QPixmap QwtPlotPanner::grab() const
     return QwtPanner::grab();
 }   
 
+/*!
+   \brief Render the plot items for an area beyond the canvas
+
+   The items are painted with the scale maps of the canvas,
+   what extrapolates the scales into the overscan.
+
+   When QwtPlot::ParallelRendering is enabled, the items with the
+   QwtPlotItem::ThreadSafeRendering attribute are rendered into images
+   by the thread pool, while the other items are painted in between.
+   Like for QwtPlot::drawCanvas() the GUI thread waits for the
+   thread pool, before the overscan is returned.
+
+   \param rect Area to be rendered in canvas coordinates
+   \return Pixmap with the content of rect
+
+   \note Items, that are aligned to the borders of the canvas
+         ( like QwtPlotLegendItem or QwtPlotTextLabel ) are
+         aligned to rect.
+
+   \sa QwtPanner::setOverscan()
+ */
+QPixmap QwtPlotPanner::grabOverscan( const QRect &rect ) const
+{
+    const QwtPlot *plt = plot();
+    const QWidget *cv = canvas();
+    if ( plt == NULL || cv == NULL )
+        return QPixmap();
+
+    QPixmap pm = QwtPainter::backingStore(
+        const_cast<QWidget *>( cv ), rect.size() );
+    QwtPainter::fillPixmap( cv, pm, rect.topLeft() );
+
+    QwtScaleMap maps[QwtPlot::axisCnt];
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+        maps[axisId] = plt->canvasMap( axisId );
+
+    QPainter painter( &pm );
+    painter.translate( -rect.topLeft() );
+
+#if !defined(QT_NO_QFUTURE)
+    if ( plt->testPaintAttribute( QwtPlot::ParallelRendering )
+        && QThread::idealThreadCount() > 1 )
+    {
+        QwtPlotItemList items;
+        int numThreadSafe = 0;
+
+        const QwtPlotItemList& itmList = plt->itemList();
+        for ( QwtPlotItemIterator it = itmList.begin();
+            it != itmList.end(); ++it )
+        {
+            QwtPlotItem *item = *it;
+            if ( item && item->isVisible() )
+            {
+                items += item;
+
+                if ( item->testItemAttribute(
+                    QwtPlotItem::ThreadSafeRendering ) )
+                {
+                    numThreadSafe++;
+                }
+            }
+        }
+
+        if ( numThreadSafe > 1 )
+        {
+            QVector<QImage> images( items.size() );
+            QImage *itemImages = images.data();
+
+            QVector<int> futureIndexes( items.size() );
+            QList< QFuture<void> > futures;
+
+            for ( int i = 0; i < items.size(); i++ )
+            {
+                const QwtPlotItem *item = items[i];
+
+                futureIndexes[i] = -1;
+                if ( item->testItemAttribute(
+                    QwtPlotItem::ThreadSafeRendering ) )
+                {
+                    itemImages[i] = qwtOverscanImage( cv, rect.size() );
+
+                    futureIndexes[i] = futures.size();
+                    futures += QtConcurrent::run( &qwtRenderOverscanItem,
+                        &itemImages[i], item,
+                        static_cast<const QwtScaleMap *>( maps ), rect );
+                }
+            }
+
+            for ( int i = 0; i < items.size(); i++ )
+            {
+                if ( futureIndexes[i] >= 0 )
+                {
+                    futures[ futureIndexes[i] ].waitForFinished();
+                    painter.drawImage( QPointF( rect.topLeft() ), itemImages[i] );
+                }
+                else
+                {
+                    qwtDrawOverscanItem( &painter, items[i], maps, rect );
+                }
+            }
+
+            painter.end();
+
+            return pm;
+        }
+    }
+#endif
+
+    plt->drawItems( &painter, rect, maps );
+    painter.end();
+
+    return pm;
+}
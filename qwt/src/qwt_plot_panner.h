@@ -14,6 +14,7 @@
 #include "qwt_panner.h"
 
 class QwtPlot;
+class QwtPlotItem;
 
 /*!
   \brief QwtPlotPanner provides panning of a plot canvas
@@ -26,6 +27,9 @@ class QwtPlot;
   of navigating on a QwtPlot widget can be implemented easily.
 
   \note The axes are not updated, while dragging the canvas
+  \note With an overscan the canvas is composed from the overscan
+        after dropping it, when all items are aligned to the scales.
+        See isScaleAligned().
   \sa QwtPlotZoomer, QwtPlotMagnifier
 */
 class QWT_EXPORT QwtPlotPanner: public QwtPanner
@@ -51,8 +55,13 @@ protected Q_SLOTS:
 protected:
     virtual QBitmap contentsMask() const;
     virtual QPixmap grab() const;
+    virtual QPixmap grabOverscan( const QRect & ) const;
+
+    virtual bool isScaleAligned( const QwtPlotItem * ) const;
 
 private:
+    bool replotFromOverscan( int dx, int dy );
+
     class PrivateData;
     PrivateData *d_data;
 };
@@ -9,6 +9,7 @@
 
 #include "qwt_plot_rasteritem.h"
 #include "qwt_scale_map.h"
+#include "qwt_scale_map_p.h"
 #include "qwt_painter.h"
 #include <qapplication.h>
 #include <qdesktopwidget.h>
@@ -41,6 +42,15 @@ public:
         QSizeF size;
         QImage image;
     } cache;
+
+    struct ValueCache
+    {
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QRectF area;
+        QSize size;
+        QVector<double> values;
+    } valueCache;
 };
 
 
@@ -467,6 +477,9 @@ void QwtPlotRasterItem::setPaintAttribute( PaintAttribute attribute, bool on )
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    if ( attribute == CacheValues && !on )
+        invalidateValueCache();
 }
 
 /*!
@@ -566,6 +579,89 @@ void QwtPlotRasterItem::invalidateCache()
     d_data->cache.size = QSize();
 }
 
+/*!
+   Invalidate the cached values
+
+   invalidateValueCache() needs to be called, when the data
+   has been modified and the CacheValues attribute is enabled.
+
+   \sa CacheValues, cachedValues(), setCachedValues()
+*/
+void QwtPlotRasterItem::invalidateValueCache()
+{
+    d_data->valueCache.values = QVector<double>();
+    d_data->valueCache.area = QRectF();
+    d_data->valueCache.size = QSize();
+}
+
+/*!
+   \brief Find cached values for an image 
+
+   \param xMap X-Scale Map of the image
+   \param yMap Y-Scale Map of the image
+   \param area Requested area for the image in scale coordinates
+   \param imageSize Size of the requested image
+   \param values Cached values, in row major order, when available
+
+   \return true, when the CacheValues attribute is enabled and
+           values for the maps, area and imageSize have been cached before
+   \sa setCachedValues(), CacheValues, renderImage()
+*/
+bool QwtPlotRasterItem::cachedValues(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &area, const QSize &imageSize,
+    QVector<double> &values ) const
+{
+    const PrivateData::ValueCache &cache = d_data->valueCache;
+
+    if ( !testPaintAttribute( CacheValues ) || cache.values.isEmpty() 
+        || cache.area != area || cache.size != imageSize )
+    {
+        return false;
+    }
+
+    // the positions of the samples depend on the maps: f.e. when
+    // switching between linear and logarithmic scales or inverting
+    // an axis the area might be the same
+
+    if ( !qwtIsSameMap( cache.xMap, xMap ) || !qwtIsSameMap( cache.yMap, yMap ) )
+        return false;
+
+    values = cache.values;
+    return true;
+}
+
+/*!
+   \brief Cache the sampled values of an image
+
+   The values are ignored, when the CacheValues attribute is not enabled.
+
+   \param xMap X-Scale Map of the image
+   \param yMap Y-Scale Map of the image
+   \param area Area of the image in scale coordinates
+   \param imageSize Size of the image
+   \param values imageSize.width() * imageSize.height() values
+                 in row major order
+
+   \sa cachedValues(), CacheValues, renderImage()
+*/
+void QwtPlotRasterItem::setCachedValues(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &area, const QSize &imageSize,
+    const QVector<double> &values ) const
+{
+    if ( !testPaintAttribute( CacheValues ) )
+        return;
+
+    PrivateData::ValueCache &cache = d_data->valueCache;
+
+    cache.xMap = xMap;
+    cache.yMap = yMap;
+    cache.area = area;
+    cache.size = imageSize;
+    cache.values = values;
+}
+
 /*!
    \brief Pixel hint
 
@@ -16,6 +16,7 @@
 #include <qglobal.h>
 #include <qstring.h>
 #include <qimage.h>
+#include <qvector.h>
 
 /*!
   \brief A class, which displays raster data
@@ -77,7 +78,22 @@ public:
           depends on the implementation of the specific QPaintEngine.
          */
 
-        PaintInDeviceResolution = 1
+        PaintInDeviceResolution = 1,
+
+        /*!
+          Derived classes, that sample values before mapping them
+          into colors ( like QwtPlotSpectrogram ), keep the values of 
+          the last rendered image, so that changes of the color map, 
+          the alpha value or the contour levels can be handled
+          without resampling the data. 
+          
+          The values are valid as long as the scale maps, area and size
+          of the image don't change. When the data itself has been modified
+          invalidateValueCache() needs to be called.
+
+          \sa cachedValues(), setCachedValues(), invalidateValueCache()
+         */
+        CacheValues = 2
     };
 
     //! Paint attributes
@@ -97,6 +113,7 @@ public:
     CachePolicy cachePolicy() const;
 
     void invalidateCache();
+    virtual void invalidateValueCache();
 
     virtual void draw( QPainter *p,
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
@@ -132,6 +149,14 @@ protected:
         const QwtScaleMap &map, const QRectF &area,
         const QSize &imageSize, double pixelSize) const;
 
+    bool cachedValues( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &area, const QSize &imageSize,
+        QVector<double> &values ) const;
+
+    void setCachedValues( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &area, const QSize &imageSize,
+        const QVector<double> &values ) const;
+
 private:
     explicit QwtPlotRasterItem( const QwtPlotRasterItem & );
     QwtPlotRasterItem &operator=( const QwtPlotRasterItem & );
@@ -9,6 +9,7 @@
 
 #include "qwt_plot_renderer.h"
 #include "qwt_plot.h"
+#include "qwt_plot_scene.h"
 #include "qwt_painter.h"
 #include "qwt_plot_layout.h"
 #include "qwt_abstract_legend.h"
@@ -101,12 +102,14 @@ class QwtPlotRenderer::PrivateData
 public:
     PrivateData():
         discardFlags( QwtPlotRenderer::DiscardNone ),
-        layoutFlags( QwtPlotRenderer::DefaultLayout )
+        layoutFlags( QwtPlotRenderer::DefaultLayout ),
+        vectorResolution( 0.0 )
     {
     }
 
     QwtPlotRenderer::DiscardFlags discardFlags;
     QwtPlotRenderer::LayoutFlags layoutFlags;
+    double vectorResolution;
 };
 
 /*! 
@@ -217,6 +220,38 @@ QwtPlotRenderer::LayoutFlags QwtPlotRenderer::layoutFlags() const
     return d_data->layoutFlags;
 }
 
+/*!
+  \brief Set an effective resolution for vector documents
+
+  When exporting to PDF or SVG all points of a curve end up in
+  the document, as there is no rounding to integers, where
+  points could be weeded out. For curves with millions of points
+  this results in huge documents, that are slow to write and to open.
+
+  When a vector resolution has been set, it is passed to QwtPainter
+  for the time of rendering, so that curves, symbols and contour lines
+  reduce their output to what is visible at this resolution.
+  For raster devices the setting has no effect.
+
+  The default setting is 0.0, what disables the reduction.
+
+  \param dotsPerInch Effective resolution in dots per inch
+  \sa vectorResolution(), QwtPainter::setVectorResolution()
+*/
+void QwtPlotRenderer::setVectorResolution( double dotsPerInch )
+{
+    d_data->vectorResolution = qMax( dotsPerInch, 0.0 );
+}
+
+/*!
+  \return Effective resolution for vector documents
+  \sa setVectorResolution()
+*/
+double QwtPlotRenderer::vectorResolution() const
+{
+    return d_data->vectorResolution;
+}
+
 /*!
   Render a plot to a file
 
@@ -570,6 +605,10 @@ void QwtPlotRenderer::render( QwtPlot *plot,
 
     // now start painting
 
+    const double vectorResolution = QwtPainter::vectorResolution();
+    if ( d_data->vectorResolution > 0.0 )
+        QwtPainter::setVectorResolution( d_data->vectorResolution );
+
     painter->save();
     painter->setWorldTransform( transform, true );
 
@@ -610,6 +649,8 @@ void QwtPlotRenderer::render( QwtPlot *plot,
 
     painter->restore();
 
+    QwtPainter::setVectorResolution( vectorResolution );
+
     // restore all setting to their original attributes.
     for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
     {
@@ -991,6 +1032,420 @@ bool QwtPlotRenderer::updateCanvasMargins( QwtPlot *plot,
     return marginsChanged;
 }
 
+/*!
+  \brief Render a scene to a \c QPaintDevice
+
+  The target rectangle is derived from the device metrics.
+
+  \param scene Scene to be rendered
+  \param paintDevice device to paint on, f.e a QImage
+
+  \sa renderScene(), QwtPlotScene
+*/
+void QwtPlotRenderer::renderTo(
+    QwtPlotScene *scene, QPaintDevice &paintDevice ) const
+{
+    int w = paintDevice.width();
+    int h = paintDevice.height();
+
+    QPainter p( &paintDevice );
+    renderScene( scene, &p, QRectF( 0, 0, w, h ) );
+}
+
+/*!
+  \brief Paint the contents of a scene into a given rectangle.
+
+  The scales are updated and the layout is calculated by the
+  plot layout of the scene - like for a plot widget.
+  As there is no widget, that could be used as reference,
+  the layout is done in the coordinates of the painter and
+  the text metrics are taken from the device of the painter
+  ( see QwtPainter::setMetricsDevice() ) instead of the screen.
+
+  So a scene can be rendered to a QImage in a thread different
+  from the GUI thread, as long as its items can be rendered
+  there ( see QwtPlotItem::ThreadSafeRendering ) and
+  nothing else accesses the scene or its items meanwhile.
+
+  DiscardLegend and DiscardCanvasFrame have no effect, as a scene
+  has no legend and no canvas frame.
+
+  \param scene Scene to be rendered
+  \param painter Painter
+  \param plotRect Bounding rectangle
+
+  \sa renderTo(), QwtPlotScene, QwtPlotLayout::activateScene()
+*/
+void QwtPlotRenderer::renderScene( QwtPlotScene *scene,
+    QPainter *painter, const QRectF &plotRect ) const
+{
+    if ( scene == NULL || painter == 0 || !painter->isActive() ||
+            !plotRect.isValid() )
+    {
+        return;
+    }
+
+    QPaintDevice *metricsDevice = QwtPainter::metricsDevice();
+    QwtPainter::setMetricsDevice( painter->device() );
+
+    scene->updateAxes();
+
+    if ( !( d_data->discardFlags & DiscardBackground ) 
+        && scene->background().style() != Qt::NoBrush )
+    {
+        QwtPainter::fillRect( painter, plotRect, scene->background() );
+    }
+
+    QRectF layoutRect = plotRect;
+
+    QwtPlotLayout *layout = scene->plotLayout();
+
+    int baseLineDists[QwtPlot::axisCnt];
+    int canvasMargins[QwtPlot::axisCnt];
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        canvasMargins[ axisId ] = layout->canvasMargin( axisId );
+        baseLineDists[ axisId ] = scene->axisMargin( axisId );
+
+        if ( d_data->layoutFlags & FrameWithScales )
+        {
+            scene->setAxisMargin( axisId, 0 );
+
+            if ( !scene->axisEnabled( axisId ) )
+            {
+                switch( axisId )
+                {
+                    case QwtPlot::yLeft:
+                        layoutRect.adjust( 1, 0, 0, 0 );
+                        break;
+                    case QwtPlot::yRight:
+                        layoutRect.adjust( 0, 0, -1, 0 );
+                        break;
+                    case QwtPlot::xTop:
+                        layoutRect.adjust( 0, 1, 0, 0 );
+                        break;
+                    case QwtPlot::xBottom:
+                        layoutRect.adjust( 0, 0, 0, -1 );
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+
+    QwtPlotLayout::Options layoutOptions = QwtPlotLayout::IgnoreScrollbars;
+
+    if ( d_data->discardFlags & DiscardTitle )
+        layoutOptions |= QwtPlotLayout::IgnoreTitle;
+
+    if ( d_data->discardFlags & DiscardFooter )
+        layoutOptions |= QwtPlotLayout::IgnoreFooter;
+
+    layout->activateScene( *scene, layoutRect, layoutOptions );
+
+    QwtScaleMap maps[QwtPlot::axisCnt];
+    buildSceneMaps( scene, layout->canvasRect(), maps );
+    if ( updateSceneMargins( scene, layout->canvasRect(), maps ) )
+    {
+        layout->activateScene( *scene, layoutRect, layoutOptions );
+        buildSceneMaps( scene, layout->canvasRect(), maps );
+    }
+
+    const double vectorResolution = QwtPainter::vectorResolution();
+    if ( d_data->vectorResolution > 0.0 )
+        QwtPainter::setVectorResolution( d_data->vectorResolution );
+
+    painter->save();
+
+    renderSceneCanvas( scene, painter, layout->canvasRect(), maps );
+
+    const QColor textColor = scene->palette().color(
+        QPalette::Active, QPalette::Text );
+
+    if ( !( d_data->discardFlags & DiscardTitle )
+        && !scene->title().isEmpty() )
+    {
+        painter->setFont( scene->font() );
+        painter->setPen( textColor );
+        scene->title().draw( painter, layout->titleRect() );
+    }
+
+    if ( !( d_data->discardFlags & DiscardFooter )
+        && !scene->footer().isEmpty() )
+    {
+        painter->setFont( scene->font() );
+        painter->setPen( textColor );
+        scene->footer().draw( painter, layout->footerRect() );
+    }
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+        renderSceneScale( scene, painter, axisId, layout->scaleRect( axisId ) );
+
+    painter->restore();
+
+    QwtPainter::setVectorResolution( vectorResolution );
+
+    // restore all setting to their original attributes.
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        scene->setAxisMargin( axisId, baseLineDists[axisId] );
+        layout->setCanvasMargin( canvasMargins[axisId], axisId );
+    }
+
+    layout->invalidate();
+
+    QwtPainter::setMetricsDevice( metricsDevice );
+}
+
+void QwtPlotRenderer::renderSceneScale( QwtPlotScene *scene,
+    QPainter *painter, int axisId, const QRectF &rect ) const
+{
+    QwtScaleDraw *sd = scene->axisScaleDraw( axisId );
+    if ( !scene->axisEnabled( axisId ) || sd == NULL )
+        return;
+
+    const QFont font = scene->axisFont( axisId );
+    const int baseDist = scene->axisMargin( axisId );
+
+    int startDist, endDist;
+    sd->getBorderDistHint( font, startDist, endDist );
+
+    painter->save();
+
+    double x, y, w;
+    double angle = 0.0;
+    int flags = 0;
+
+    QRectF titleRect = rect;
+
+    const QwtText title = scene->axisTitle( axisId );
+
+    const int titleOffset = baseDist + scene->axisSpacing( axisId )
+        + qCeil( sd->extent( font ) );
+
+    switch ( axisId )
+    {
+        case QwtPlot::yLeft:
+        {
+            x = rect.right() - 1.0 - baseDist;
+            y = rect.y() + startDist;
+            w = rect.height() - startDist - endDist;
+
+            angle = -90.0;
+            flags = Qt::AlignTop;
+            titleRect.setRect( rect.left(), rect.bottom(),
+                rect.height(), rect.width() - titleOffset );
+            break;
+        }
+        case QwtPlot::yRight:
+        {
+            x = rect.left() + baseDist;
+            y = rect.y() + startDist;
+            w = rect.height() - startDist - endDist;
+
+            // the title of the right axis is inverted like
+            // with QwtScaleWidget::TitleInverted
+
+            angle = 90.0;
+            flags = Qt::AlignTop;
+            titleRect.setRect( rect.left() + titleOffset, rect.bottom(),
+                rect.height(), rect.width() - titleOffset );
+            titleRect.setRect( titleRect.x() + titleRect.height(),
+                titleRect.y() - titleRect.width(),
+                titleRect.width(), titleRect.height() );
+            break;
+        }
+        case QwtPlot::xTop:
+        {
+            x = rect.left() + startDist;
+            y = rect.bottom() - 1.0 - baseDist;
+            w = rect.width() - startDist - endDist;
+
+            flags = Qt::AlignTop;
+            titleRect.setBottom( rect.bottom() - titleOffset );
+            break;
+        }
+        case QwtPlot::xBottom:
+        default:
+        {
+            x = rect.left() + startDist;
+            y = rect.top() + baseDist;
+            w = rect.width() - startDist - endDist;
+
+            flags = Qt::AlignBottom;
+            titleRect.setTop( rect.top() + titleOffset );
+            break;
+        }
+    }
+
+    const QColor textColor = scene->palette().color(
+        QPalette::Active, QPalette::Text );
+
+    if ( !title.isEmpty() )
+    {
+        painter->save();
+        painter->setFont( scene->font() );
+        painter->setPen( textColor );
+
+        painter->translate( titleRect.x(), titleRect.y() );
+        if ( angle != 0.0 )
+            painter->rotate( angle );
+
+        QwtText text = title;
+        text.setRenderFlags( ( title.renderFlags() &
+            ~( Qt::AlignTop | Qt::AlignBottom | Qt::AlignVCenter ) ) | flags );
+        text.draw( painter,
+            QRectF( 0.0, 0.0, titleRect.width(), titleRect.height() ) );
+
+        painter->restore();
+    }
+
+    painter->setFont( font );
+
+    const QPointF sdPos = sd->pos();
+    const double sdLength = sd->length();
+
+    sd->move( x, y );
+    sd->setLength( w );
+
+    sd->draw( painter, scene->palette() );
+
+    sd->move( sdPos );
+    sd->setLength( sdLength );
+
+    painter->restore();
+}
+
+void QwtPlotRenderer::renderSceneCanvas( const QwtPlotScene *scene,
+    QPainter *painter, const QRectF &canvasRect, 
+    const QwtScaleMap *maps ) const
+{
+    if ( d_data->layoutFlags & FrameWithScales )
+    {
+        painter->save();
+
+        const QRectF r = canvasRect.adjusted( -1.0, -1.0, 0.0, 0.0 );
+
+        painter->setPen( QPen( Qt::black ) );
+
+        if ( !( d_data->discardFlags & DiscardCanvasBackground ) )
+            painter->setBrush( scene->canvasBackground() );
+
+        QwtPainter::drawRect( painter, r );
+
+        painter->restore();
+    }
+    else if ( !( d_data->discardFlags & DiscardCanvasBackground ) )
+    {
+        QwtPainter::fillRect( painter, canvasRect, scene->canvasBackground() );
+    }
+
+    painter->save();
+    painter->setClipRect( canvasRect );
+
+    const QwtPlotItemList &itemList = scene->itemList();
+    for ( QwtPlotItemIterator it = itemList.begin();
+        it != itemList.end(); ++it )
+    {
+        QwtPlotItem *item = *it;
+        if ( item && item->isVisible() )
+        {
+            painter->save();
+
+            painter->setRenderHint( QPainter::Antialiasing,
+                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+            painter->setRenderHint( QPainter::HighQualityAntialiasing,
+                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+            item->draw( painter, maps[item->xAxis()],
+                maps[item->yAxis()], canvasRect );
+
+            painter->restore();
+        }
+    }
+
+    painter->restore();
+}
+
+void QwtPlotRenderer::buildSceneMaps( const QwtPlotScene *scene,
+    const QRectF &canvasRect, QwtScaleMap maps[] ) const
+{
+    const QwtPlotLayout *layout = scene->plotLayout();
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        maps[axisId].setTransformation(
+            scene->axisScaleEngine( axisId )->transformation() );
+
+        const QwtScaleDiv &scaleDiv = scene->axisScaleDiv( axisId );
+        maps[axisId].setScaleInterval(
+            scaleDiv.lowerBound(), scaleDiv.upperBound() );
+
+        double from, to;
+        if ( scene->axisEnabled( axisId ) )
+        {
+            int sDist, eDist;
+            scene->axisScaleDraw( axisId )->getBorderDistHint(
+                scene->axisFont( axisId ), sDist, eDist );
+
+            const QRectF scaleRect = layout->scaleRect( axisId );
+
+            if ( axisId == QwtPlot::xTop || axisId == QwtPlot::xBottom )
+            {
+                from = scaleRect.left() + sDist;
+                to = scaleRect.right() - eDist;
+            }
+            else
+            {
+                from = scaleRect.bottom() - eDist;
+                to = scaleRect.top() + sDist;
+            }
+        }
+        else
+        {
+            int margin = 0;
+            if ( !layout->alignCanvasToScale( axisId ) )
+                margin = layout->canvasMargin( axisId );
+
+            if ( axisId == QwtPlot::yLeft || axisId == QwtPlot::yRight )
+            {
+                from = canvasRect.bottom() - margin;
+                to = canvasRect.top() + margin;
+            }
+            else
+            {
+                from = canvasRect.left() + margin;
+                to = canvasRect.right() - margin;
+            }
+        }
+        maps[axisId].setPaintInterval( from, to );
+    }
+}
+
+bool QwtPlotRenderer::updateSceneMargins( QwtPlotScene *scene,
+    const QRectF &canvasRect, const QwtScaleMap maps[] ) const
+{
+    double margins[QwtPlot::axisCnt];
+    scene->getCanvasMarginsHint( maps, canvasRect,
+        margins[QwtPlot::yLeft], margins[QwtPlot::xTop], 
+        margins[QwtPlot::yRight], margins[QwtPlot::xBottom] );
+
+    bool marginsChanged = false;
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        if ( margins[axisId] >= 0.0 )
+        {
+            const int m = qCeil( margins[axisId] );
+            scene->plotLayout()->setCanvasMargin( m, axisId);
+            marginsChanged = true;
+        }
+    }
+
+    return marginsChanged;
+}
+
 /*!
    \brief Execute a file dialog and render the plot to the selected file
 
@@ -15,6 +15,7 @@
 #include <qsize.h>
 
 class QwtPlot;
+class QwtPlotScene;
 class QwtScaleMap;
 class QRectF;
 class QPainter;
@@ -110,6 +111,9 @@ public:
     void setLayoutFlags( LayoutFlags flags );
     LayoutFlags layoutFlags() const;
 
+    void setVectorResolution( double dotsPerInch );
+    double vectorResolution() const;
+
     void renderDocument( QwtPlot *, const QString &fileName,
         const QSizeF &sizeMM, int resolution = 85 );
 
@@ -134,6 +138,11 @@ public:
     virtual void render( QwtPlot *,
         QPainter *, const QRectF &rect ) const;
 
+    void renderTo( QwtPlotScene *, QPaintDevice & ) const;
+
+    virtual void renderScene( QwtPlotScene *,
+        QPainter *, const QRectF &rect ) const;
+
     virtual void renderTitle( const QwtPlot *,
         QPainter *, const QRectF & ) const;
 
@@ -161,6 +170,18 @@ private:
     bool updateCanvasMargins( QwtPlot *,
         const QRectF &, const QwtScaleMap maps[] ) const;
 
+    void renderSceneScale( QwtPlotScene *, QPainter *,
+        int axisId, const QRectF & ) const;
+
+    void renderSceneCanvas( const QwtPlotScene *, QPainter *,
+        const QRectF &canvasRect, const QwtScaleMap *maps ) const;
+
+    void buildSceneMaps( const QwtPlotScene *,
+        const QRectF &, QwtScaleMap maps[] ) const;
+
+    bool updateSceneMargins( QwtPlotScene *,
+        const QRectF &, const QwtScaleMap maps[] ) const;
+
 private:
     class PrivateData;
     PrivateData *d_data;
@@ -0,0 +1,882 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_scene.h"
+#include "qwt_plot_layout.h"
+#include "qwt_scale_draw.h"
+#include "qwt_scale_div.h"
+#include "qwt_scale_engine.h"
+#include "qwt_scale_map.h"
+#include "qwt_interval.h"
+
+static inline bool qwtAxisValid( int axisId )
+{
+    return ( axisId >= 0 && axisId < QwtPlot::axisCnt );
+}
+
+static QwtScaleDraw::Alignment qwtScaleAlignment( int axisId )
+{
+    switch( axisId )
+    {
+        case QwtPlot::yLeft:
+            return QwtScaleDraw::LeftScale;
+        case QwtPlot::yRight:
+            return QwtScaleDraw::RightScale;
+        case QwtPlot::xTop:
+            return QwtScaleDraw::TopScale;
+        default:
+            return QwtScaleDraw::BottomScale;
+    }
+}
+
+class QwtPlotScene::AxisData
+{
+public:
+    bool isEnabled;
+    bool doAutoScale;
+
+    double minValue;
+    double maxValue;
+    double stepSize;
+
+    int maxMajor;
+    int maxMinor;
+
+    bool isValid;
+
+    QwtScaleDiv scaleDiv;
+    QwtScaleEngine *scaleEngine;
+    QwtScaleDraw *scaleDraw;
+
+    QwtText title;
+    QFont font;
+
+    int margin;
+    int spacing;
+};
+
+class QwtPlotScene::PrivateData
+{
+public:
+    class LessZThan
+    {
+    public:
+        inline bool operator()( const QwtPlotItem *item1,
+            const QwtPlotItem *item2 ) const
+        {
+            return item1->z() < item2->z();
+        }
+    };
+
+    QwtText title;
+    QwtText footer;
+
+    QFont font;
+    QPalette palette;
+
+    QBrush background;
+    QBrush canvasBackground;
+
+    QwtPlotLayout *layout;
+
+    AxisData axisData[QwtPlot::axisCnt];
+
+    QwtPlotItemList itemList;
+};
+
+/*!
+  \brief Constructor
+
+  The scene is initialized like a QwtPlot: the yLeft and xBottom axes
+  are enabled and autoscaled, the canvas background is white and
+  the text is painted in black.
+ */
+QwtPlotScene::QwtPlotScene()
+{
+    d_data = new PrivateData;
+
+    d_data->layout = new QwtPlotLayout;
+
+    d_data->palette.setColor( QPalette::WindowText, Qt::black );
+    d_data->palette.setColor( QPalette::Text, Qt::black );
+    d_data->palette.setCurrentColorGroup( QPalette::Active );
+
+    d_data->background = Qt::NoBrush;
+    d_data->canvasBackground = Qt::white;
+
+    QFont titleFont = d_data->font;
+    titleFont.setPointSize( 14 );
+    titleFont.setBold( true );
+
+    d_data->title.setFont( titleFont );
+    d_data->title.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
+
+    d_data->footer.setFont( d_data->font );
+    d_data->footer.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
+
+    const QFont scaleFont( d_data->font.family(), 10 );
+    const QFont axisTitleFont( d_data->font.family(), 12, QFont::Bold );
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        AxisData &d = d_data->axisData[axisId];
+
+        d.isEnabled = ( axisId == QwtPlot::yLeft
+            || axisId == QwtPlot::xBottom );
+
+        d.doAutoScale = true;
+
+        d.minValue = 0.0;
+        d.maxValue = 1000.0;
+        d.stepSize = 0.0;
+
+        d.maxMinor = 5;
+        d.maxMajor = 8;
+
+        d.isValid = false;
+
+        d.scaleEngine = new QwtLinearScaleEngine;
+
+        d.scaleDraw = new QwtScaleDraw;
+        d.scaleDraw->setAlignment( qwtScaleAlignment( axisId ) );
+        d.scaleDraw->setTransformation( d.scaleEngine->transformation() );
+
+        d.font = scaleFont;
+
+        d.title.setFont( axisTitleFont );
+        d.title.setRenderFlags( Qt::AlignHCenter | Qt::TextExpandTabs
+            | Qt::TextWordWrap );
+
+        d.margin = 2;
+        d.spacing = 2;
+    }
+}
+
+//! Destructor
+QwtPlotScene::~QwtPlotScene()
+{
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        delete d_data->axisData[axisId].scaleEngine;
+        delete d_data->axisData[axisId].scaleDraw;
+    }
+
+    delete d_data->layout;
+    delete d_data;
+}
+
+/*!
+  Change the title of the scene
+  \param title New title
+  \sa title()
+*/
+void QwtPlotScene::setTitle( const QString &title )
+{
+    d_data->title.setText( title );
+}
+
+/*!
+  Change the title of the scene
+  \param title New title
+  \sa title()
+*/
+void QwtPlotScene::setTitle( const QwtText &title )
+{
+    d_data->title = title;
+}
+
+//! \return Title of the scene
+QwtText QwtPlotScene::title() const
+{
+    return d_data->title;
+}
+
+/*!
+  Change the footer of the scene
+  \param footer New footer
+  \sa footer()
+*/
+void QwtPlotScene::setFooter( const QString &footer )
+{
+    d_data->footer.setText( footer );
+}
+
+/*!
+  Change the footer of the scene
+  \param footer New footer
+  \sa footer()
+*/
+void QwtPlotScene::setFooter( const QwtText &footer )
+{
+    d_data->footer = footer;
+}
+
+//! \return Footer of the scene
+QwtText QwtPlotScene::footer() const
+{
+    return d_data->footer;
+}
+
+/*!
+  \brief Set the font for texts without a font of their own
+
+  \param font Font
+  \sa font(), setAxisFont()
+*/
+void QwtPlotScene::setFont( const QFont &font )
+{
+    d_data->font = font;
+}
+
+//! \return Font for texts without a font of their own
+QFont QwtPlotScene::font() const
+{
+    return d_data->font;
+}
+
+/*!
+  \brief Set the palette for texts and scales
+
+  The QPalette::Text color is used for the texts and the tick labels,
+  QPalette::WindowText for the ticks and the backbones of the scales.
+
+  \param palette Palette
+  \sa palette()
+*/
+void QwtPlotScene::setPalette( const QPalette &palette )
+{
+    d_data->palette = palette;
+    d_data->palette.setCurrentColorGroup( QPalette::Active );
+}
+
+//! \return Palette for texts and scales
+QPalette QwtPlotScene::palette() const
+{
+    return d_data->palette;
+}
+
+/*!
+  \brief Set the background of the scene
+
+  The default setting is Qt::NoBrush, what leaves the paint device
+  untouched outside of the canvas.
+
+  \param brush Background brush
+  \sa background(), setCanvasBackground()
+*/
+void QwtPlotScene::setBackground( const QBrush &brush )
+{
+    d_data->background = brush;
+}
+
+//! \return Background of the scene
+QBrush QwtPlotScene::background() const
+{
+    return d_data->background;
+}
+
+/*!
+  \brief Set the background of the canvas
+  \param brush Background brush
+  \sa canvasBackground(), setBackground()
+*/
+void QwtPlotScene::setCanvasBackground( const QBrush &brush )
+{
+    d_data->canvasBackground = brush;
+}
+
+//! \return Background of the canvas
+QBrush QwtPlotScene::canvasBackground() const
+{
+    return d_data->canvasBackground;
+}
+
+/*!
+  \brief Assign a new layout engine
+
+  \param layout Layout engine, that will be deleted by the scene
+  \sa plotLayout()
+*/
+void QwtPlotScene::setPlotLayout( QwtPlotLayout *layout )
+{
+    if ( layout && layout != d_data->layout )
+    {
+        delete d_data->layout;
+        d_data->layout = layout;
+    }
+}
+
+//! \return Layout engine of the scene
+QwtPlotLayout *QwtPlotScene::plotLayout()
+{
+    return d_data->layout;
+}
+
+//! \return Layout engine of the scene
+const QwtPlotLayout *QwtPlotScene::plotLayout() const
+{
+    return d_data->layout;
+}
+
+/*!
+  \brief Enable or disable an axis
+
+  \param axisId Axis index
+  \param on On/Off
+  \sa axisEnabled()
+*/
+void QwtPlotScene::enableAxis( int axisId, bool on )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].isEnabled = on;
+}
+
+/*!
+  \return True, if a specified axis is enabled
+  \param axisId Axis index
+*/
+bool QwtPlotScene::axisEnabled( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].isEnabled;
+
+    return false;
+}
+
+/*!
+  Change the scale engine for an axis
+
+  \param axisId Axis index
+  \param scaleEngine Scale engine, that will be deleted by the scene
+
+  \sa axisScaleEngine()
+*/
+void QwtPlotScene::setAxisScaleEngine( int axisId, QwtScaleEngine *scaleEngine )
+{
+    if ( qwtAxisValid( axisId ) && scaleEngine != NULL )
+    {
+        AxisData &d = d_data->axisData[axisId];
+
+        if ( scaleEngine != d.scaleEngine )
+        {
+            delete d.scaleEngine;
+            d.scaleEngine = scaleEngine;
+        }
+
+        d.scaleDraw->setTransformation( scaleEngine->transformation() );
+        d.isValid = false;
+    }
+}
+
+/*!
+  \param axisId Axis index
+  \return Scale engine for a specific axis
+*/
+QwtScaleEngine *QwtPlotScene::axisScaleEngine( int axisId )
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].scaleEngine;
+
+    return NULL;
+}
+
+/*!
+  \param axisId Axis index
+  \return Scale engine for a specific axis
+*/
+const QwtScaleEngine *QwtPlotScene::axisScaleEngine( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].scaleEngine;
+
+    return NULL;
+}
+
+/*!
+  \brief Set a scale draw
+
+  The alignment of the scale draw is adjusted to the axis.
+
+  \param axisId Axis index
+  \param scaleDraw Scale draw, that will be deleted by the scene
+
+  \sa axisScaleDraw()
+*/
+void QwtPlotScene::setAxisScaleDraw( int axisId, QwtScaleDraw *scaleDraw )
+{
+    if ( qwtAxisValid( axisId ) && scaleDraw != NULL )
+    {
+        AxisData &d = d_data->axisData[axisId];
+
+        if ( scaleDraw != d.scaleDraw )
+        {
+            delete d.scaleDraw;
+            d.scaleDraw = scaleDraw;
+        }
+
+        scaleDraw->setAlignment( qwtScaleAlignment( axisId ) );
+        scaleDraw->setTransformation( d.scaleEngine->transformation() );
+        scaleDraw->setScaleDiv( d.scaleDiv );
+    }
+}
+
+/*!
+  \param axisId Axis index
+  \return Scale draw of a specific axis
+*/
+QwtScaleDraw *QwtPlotScene::axisScaleDraw( int axisId )
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].scaleDraw;
+
+    return NULL;
+}
+
+/*!
+  \param axisId Axis index
+  \return Scale draw of a specific axis
+*/
+const QwtScaleDraw *QwtPlotScene::axisScaleDraw( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].scaleDraw;
+
+    return NULL;
+}
+
+/*!
+  \brief Enable autoscaling for a specified axis
+
+  \param axisId Axis index
+  \param on On/Off
+  \sa axisAutoScale(), updateAxes()
+*/
+void QwtPlotScene::setAxisAutoScale( int axisId, bool on )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].doAutoScale = on;
+}
+
+/*!
+  \return True, if autoscaling is enabled
+  \param axisId Axis index
+*/
+bool QwtPlotScene::axisAutoScale( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].doAutoScale;
+
+    return false;
+}
+
+/*!
+  \brief Disable autoscaling and specify a fixed scale for an axis
+
+  \param axisId Axis index
+  \param min Minimum of the scale
+  \param max Maximum of the scale
+  \param stepSize Major step size. If <code>step == 0</code>, the step size is
+                  calculated automatically using the maxMajor setting.
+
+  \sa setAxisScaleDiv(), QwtPlot::setAxisScale()
+*/
+void QwtPlotScene::setAxisScale( int axisId,
+    double min, double max, double stepSize )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        AxisData &d = d_data->axisData[axisId];
+
+        d.doAutoScale = false;
+        d.isValid = false;
+
+        d.minValue = min;
+        d.maxValue = max;
+        d.stepSize = stepSize;
+    }
+}
+
+/*!
+  \brief Disable autoscaling and specify a fixed scale division
+
+  \param axisId Axis index
+  \param scaleDiv Scale division
+
+  \sa setAxisScale(), QwtPlot::setAxisScaleDiv()
+*/
+void QwtPlotScene::setAxisScaleDiv( int axisId, const QwtScaleDiv &scaleDiv )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        AxisData &d = d_data->axisData[axisId];
+
+        d.doAutoScale = false;
+        d.scaleDiv = scaleDiv;
+        d.isValid = true;
+
+        d.scaleDraw->setScaleDiv( scaleDiv );
+    }
+}
+
+/*!
+  \brief Return the scale division of a specified axis
+
+  The scale division is calculated in updateAxes().
+
+  \param axisId Axis index
+  \return Scale division
+*/
+const QwtScaleDiv &QwtPlotScene::axisScaleDiv( int axisId ) const
+{
+    return d_data->axisData[axisId].scaleDiv;
+}
+
+/*!
+  Set the maximum number of major scale intervals for a specified axis
+
+  \param axisId Axis index
+  \param maxMajor Maximum number of major steps
+  \sa axisMaxMajor()
+*/
+void QwtPlotScene::setAxisMaxMajor( int axisId, int maxMajor )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        maxMajor = qBound( 1, maxMajor, 10000 );
+
+        AxisData &d = d_data->axisData[axisId];
+        if ( maxMajor != d.maxMajor )
+        {
+            d.maxMajor = maxMajor;
+            d.isValid = false;
+        }
+    }
+}
+
+/*!
+  \return The maximum number of major ticks for a specified axis
+  \param axisId Axis index
+*/
+int QwtPlotScene::axisMaxMajor( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].maxMajor;
+
+    return 0;
+}
+
+/*!
+  Set the maximum number of minor scale intervals for a specified axis
+
+  \param axisId Axis index
+  \param maxMinor Maximum number of minor steps
+  \sa axisMaxMinor()
+*/
+void QwtPlotScene::setAxisMaxMinor( int axisId, int maxMinor )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        maxMinor = qBound( 0, maxMinor, 100 );
+
+        AxisData &d = d_data->axisData[axisId];
+        if ( maxMinor != d.maxMinor )
+        {
+            d.maxMinor = maxMinor;
+            d.isValid = false;
+        }
+    }
+}
+
+/*!
+  \return The maximum number of minor ticks for a specified axis
+  \param axisId Axis index
+*/
+int QwtPlotScene::axisMaxMinor( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].maxMinor;
+
+    return 0;
+}
+
+/*!
+  \brief Change the title of a specified axis
+
+  \param axisId Axis index
+  \param title Axis title
+*/
+void QwtPlotScene::setAxisTitle( int axisId, const QString &title )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].title.setText( title );
+}
+
+/*!
+  \brief Change the title of a specified axis
+
+  \param axisId Axis index
+  \param title Axis title
+*/
+void QwtPlotScene::setAxisTitle( int axisId, const QwtText &title )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].title = title;
+}
+
+/*!
+  \return Title of a specified axis
+  \param axisId Axis index
+*/
+QwtText QwtPlotScene::axisTitle( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].title;
+
+    return QwtText();
+}
+
+/*!
+  \brief Change the font of the tick labels of an axis
+
+  \param axisId Axis index
+  \param font Font
+*/
+void QwtPlotScene::setAxisFont( int axisId, const QFont &font )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].font = font;
+}
+
+/*!
+  \return Font of the tick labels of a specified axis
+  \param axisId Axis index
+*/
+QFont QwtPlotScene::axisFont( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].font;
+
+    return QFont();
+}
+
+/*!
+  \brief Specify the distance between the backbone and the canvas
+
+  \param axisId Axis index
+  \param margin Margin
+  \sa QwtScaleWidget::setMargin()
+*/
+void QwtPlotScene::setAxisMargin( int axisId, int margin )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].margin = qMax( margin, 0 );
+}
+
+/*!
+  \return Distance between the backbone and the canvas
+  \param axisId Axis index
+*/
+int QwtPlotScene::axisMargin( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].margin;
+
+    return 0;
+}
+
+/*!
+  \brief Specify the distance between the tick labels and the axis title
+
+  \param axisId Axis index
+  \param spacing Spacing
+  \sa QwtScaleWidget::setSpacing()
+*/
+void QwtPlotScene::setAxisSpacing( int axisId, int spacing )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].spacing = qMax( spacing, 0 );
+}
+
+/*!
+  \return Distance between the tick labels and the axis title
+  \param axisId Axis index
+*/
+int QwtPlotScene::axisSpacing( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].spacing;
+
+    return 0;
+}
+
+/*!
+  \brief Insert an item into the scene
+
+  The items are sorted by their z value. The scene doesn't take
+  ownership of the item and doesn't call QwtPlotItem::attach().
+
+  \param item Plot item
+  \sa detachItem(), itemList()
+*/
+void QwtPlotScene::attachItem( QwtPlotItem *item )
+{
+    if ( item == NULL || d_data->itemList.contains( item ) )
+        return;
+
+    QwtPlotItemList::iterator it = qUpperBound( d_data->itemList.begin(),
+        d_data->itemList.end(), item, PrivateData::LessZThan() );
+
+    d_data->itemList.insert( it, item );
+}
+
+/*!
+  \brief Remove an item from the scene
+
+  \param item Plot item
+  \sa attachItem(), detachItems()
+*/
+void QwtPlotScene::detachItem( QwtPlotItem *item )
+{
+    d_data->itemList.removeAll( item );
+}
+
+/*!
+  \brief Remove all items from the scene
+  \sa detachItem()
+*/
+void QwtPlotScene::detachItems()
+{
+    d_data->itemList.clear();
+}
+
+//! \return List of the items of the scene, sorted by their z value
+const QwtPlotItemList &QwtPlotScene::itemList() const
+{
+    return d_data->itemList;
+}
+
+/*!
+  \brief Rebuild the axes scales
+
+  The scale divisions of all autoscaled axes are calculated from the
+  bounding rectangles of the items like in QwtPlot::updateAxes().
+  Afterwards the scale draws and all items with
+  QwtPlotItem::ScaleInterest are updated.
+
+  updateAxes() is called by QwtPlotRenderer before rendering the scene.
+
+  \sa QwtPlot::updateAxes()
+*/
+void QwtPlotScene::updateAxes()
+{
+    QwtInterval intv[QwtPlot::axisCnt];
+
+    const QwtPlotItemList &itmList = d_data->itemList;
+
+    QwtPlotItemIterator it;
+    for ( it = itmList.begin(); it != itmList.end(); ++it )
+    {
+        const QwtPlotItem *item = *it;
+
+        if ( !item->testItemAttribute( QwtPlotItem::AutoScale ) )
+            continue;
+
+        if ( !item->isVisible() )
+            continue;
+
+        if ( axisAutoScale( item->xAxis() ) || axisAutoScale( item->yAxis() ) )
+        {
+            const QRectF rect = item->autoScaleRect();
+
+            if ( rect.width() >= 0.0 )
+                intv[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
+
+            if ( rect.height() >= 0.0 )
+                intv[item->yAxis()] |= QwtInterval( rect.top(), rect.bottom() );
+        }
+    }
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        AxisData &d = d_data->axisData[axisId];
+
+        double minValue = d.minValue;
+        double maxValue = d.maxValue;
+        double stepSize = d.stepSize;
+
+        if ( d.doAutoScale && intv[axisId].isValid() )
+        {
+            d.isValid = false;
+
+            minValue = intv[axisId].minValue();
+            maxValue = intv[axisId].maxValue();
+
+            d.scaleEngine->autoScale( d.maxMajor,
+                minValue, maxValue, stepSize );
+        }
+        if ( !d.isValid )
+        {
+            d.scaleDiv = d.scaleEngine->divideScale(
+                minValue, maxValue,
+                d.maxMajor, d.maxMinor, stepSize );
+            d.isValid = true;
+        }
+
+        d.scaleDraw->setScaleDiv( d.scaleDiv );
+    }
+
+    for ( it = itmList.begin(); it != itmList.end(); ++it )
+    {
+        QwtPlotItem *item = *it;
+        if ( item->testItemInterest( QwtPlotItem::ScaleInterest ) )
+        {
+            item->updateScaleDiv( axisScaleDiv( item->xAxis() ),
+                axisScaleDiv( item->yAxis() ) );
+        }
+    }
+}
+
+/*!
+  \brief Calculate the canvas margins
+
+  \param maps QwtPlot::axisCnt maps, mapping between plot and paint device coordinates
+  \param canvasRect Bounding rectangle where to paint
+  \param left Return parameter for the left margin
+  \param top Return parameter for the top margin
+  \param right Return parameter for the right margin
+  \param bottom Return parameter for the bottom margin
+
+  \sa QwtPlot::getCanvasMarginsHint(), QwtPlotItem::getCanvasMarginHint()
+*/
+void QwtPlotScene::getCanvasMarginsHint(
+    const QwtScaleMap maps[], const QRectF &canvasRect,
+    double &left, double &top, double &right, double &bottom) const
+{
+    left = top = right = bottom = -1.0;
+
+    const QwtPlotItemList &itmList = d_data->itemList;
+    for ( QwtPlotItemIterator it = itmList.begin();
+        it != itmList.end(); ++it )
+    {
+        const QwtPlotItem *item = *it;
+        if ( item->testItemAttribute( QwtPlotItem::Margins ) )
+        {
+            double m[ QwtPlot::axisCnt ];
+            item->getCanvasMarginHint(
+                maps[ item->xAxis() ], maps[ item->yAxis() ],
+                canvasRect, m[QwtPlot::yLeft], m[QwtPlot::xTop],
+                m[QwtPlot::yRight], m[QwtPlot::xBottom] );
+
+            left = qMax( left, m[QwtPlot::yLeft] );
+            top = qMax( top, m[QwtPlot::xTop] );
+            right = qMax( right, m[QwtPlot::yRight] );
+            bottom = qMax( bottom, m[QwtPlot::xBottom] );
+        }
+    }
+}
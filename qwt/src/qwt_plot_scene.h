@@ -0,0 +1,154 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_SCENE_H
+#define QWT_PLOT_SCENE_H
+
+#include "qwt_global.h"
+#include "qwt_plot.h"
+#include "qwt_text.h"
+#include <qfont.h>
+#include <qbrush.h>
+#include <qpalette.h>
+
+class QwtPlotLayout;
+class QwtScaleDraw;
+class QwtScaleDiv;
+class QwtScaleEngine;
+class QwtScaleMap;
+class QRectF;
+
+/*!
+  \brief Description of a plot, that can be rendered without widgets
+
+  QwtPlotScene holds everything, that is needed to lay out and paint
+  a plot: title, footer, the axes with their scale engines,
+  scale divisions and scale draws, and the list of plot items.
+  As it is no QObject and doesn't create any widgets, a scene can
+  be rendered by QwtPlotRenderer without having a plot widget:
+
+  \code
+    QwtPlotScene scene;
+    scene.setTitle( "Thumbnail" );
+    scene.attachItem( curve );
+
+    QImage image( 400, 300, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::white );
+
+    QwtPlotRenderer renderer;
+    renderer.renderTo( &scene, image );
+  \endcode
+
+  The layout is calculated by the plotLayout() of the scene, the
+  scales are painted using the same QwtScaleDraw objects as on screen.
+  There is no legend and the canvas has no frame.
+
+  \note The items are not owned by the scene. An item might be
+        attached to a plot widget and to a scene at the same time.
+
+  The text metrics are taken from the paint device of the renderer
+  instead of the screen. So a scene can be rendered to a QImage
+  in a worker thread, as long as its items can be rendered there
+  ( see QwtPlotItem::ThreadSafeRendering ) and neither the scene nor
+  its items are accessed by other threads meanwhile.
+
+  \sa QwtPlotRenderer::renderScene(), QwtPlotLayout::activateScene()
+*/
+class QWT_EXPORT QwtPlotScene
+{
+public:
+    QwtPlotScene();
+    virtual ~QwtPlotScene();
+
+    void setTitle( const QString & );
+    void setTitle( const QwtText & );
+    QwtText title() const;
+
+    void setFooter( const QString & );
+    void setFooter( const QwtText & );
+    QwtText footer() const;
+
+    void setFont( const QFont & );
+    QFont font() const;
+
+    void setPalette( const QPalette & );
+    QPalette palette() const;
+
+    void setBackground( const QBrush & );
+    QBrush background() const;
+
+    void setCanvasBackground( const QBrush & );
+    QBrush canvasBackground() const;
+
+    void setPlotLayout( QwtPlotLayout * );
+    QwtPlotLayout *plotLayout();
+    const QwtPlotLayout *plotLayout() const;
+
+    // axes
+
+    void enableAxis( int axisId, bool on = true );
+    bool axisEnabled( int axisId ) const;
+
+    void setAxisScaleEngine( int axisId, QwtScaleEngine * );
+    QwtScaleEngine *axisScaleEngine( int axisId );
+    const QwtScaleEngine *axisScaleEngine( int axisId ) const;
+
+    void setAxisScaleDraw( int axisId, QwtScaleDraw * );
+    QwtScaleDraw *axisScaleDraw( int axisId );
+    const QwtScaleDraw *axisScaleDraw( int axisId ) const;
+
+    void setAxisAutoScale( int axisId, bool on = true );
+    bool axisAutoScale( int axisId ) const;
+
+    void setAxisScale( int axisId, double min, double max, double stepSize = 0 );
+    void setAxisScaleDiv( int axisId, const QwtScaleDiv & );
+    const QwtScaleDiv &axisScaleDiv( int axisId ) const;
+
+    void setAxisMaxMajor( int axisId, int maxMajor );
+    int axisMaxMajor( int axisId ) const;
+
+    void setAxisMaxMinor( int axisId, int maxMinor );
+    int axisMaxMinor( int axisId ) const;
+
+    void setAxisTitle( int axisId, const QString & );
+    void setAxisTitle( int axisId, const QwtText & );
+    QwtText axisTitle( int axisId ) const;
+
+    void setAxisFont( int axisId, const QFont & );
+    QFont axisFont( int axisId ) const;
+
+    void setAxisMargin( int axisId, int margin );
+    int axisMargin( int axisId ) const;
+
+    void setAxisSpacing( int axisId, int spacing );
+    int axisSpacing( int axisId ) const;
+
+    // items
+
+    void attachItem( QwtPlotItem * );
+    void detachItem( QwtPlotItem * );
+    void detachItems();
+
+    const QwtPlotItemList &itemList() const;
+
+    virtual void updateAxes();
+
+    virtual void getCanvasMarginsHint(
+        const QwtScaleMap maps[], const QRectF &canvasRect,
+        double &left, double &top, double &right, double &bottom) const;
+
+private:
+    Q_DISABLE_COPY(QwtPlotScene)
+
+    class AxisData;
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -12,6 +12,65 @@
 #include "qwt_scale_map.h"
 #include "qwt_painter.h"
 #include <qpainter.h>
+#include <qimage.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtSpectroDotsCommand
+{
+public:
+    const QwtSeriesData<QwtPoint3D> *series;
+    int from;
+    int to;
+
+    const QwtColorMap *colorMap;
+    QwtInterval colorRange;
+
+    // NULL, when the colors are calculated by QwtColorMap::rgb()
+    const QRgb *colorTable;
+};
+
+static void qwtRenderDots(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSpectroDotsCommand command, const QPoint &pos, QImage *image )
+{
+    QRgb *bits = reinterpret_cast<QRgb *>( image->bits() );
+
+    const int w = image->width();
+    const int h = image->height();
+
+    const int x0 = pos.x();
+    const int y0 = pos.y();
+
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QwtPoint3D sample = command.series->sample( i );
+
+        const int x = qRound( xMap.transform( sample.x() ) ) - x0;
+        const int y = qRound( yMap.transform( sample.y() ) ) - y0;
+
+        if ( x >= 0 && x < w && y >= 0 && y < h )
+        {
+            QRgb rgb;
+            if ( command.colorTable )
+            {
+                const uint index = command.colorMap->colorIndex(
+                    256, command.colorRange, sample.z() );
+
+                rgb = command.colorTable[ qMin( index, 255u ) ];
+            }
+            else
+            {
+                rgb = command.colorMap->rgb( command.colorRange, sample.z() );
+            }
+
+            bits[ y * w + x ] = rgb;
+        }
+    }
+}
 
 class QwtPlotSpectroCurve::PrivateData
 {
@@ -272,6 +331,19 @@ void QwtPlotSpectroCurve::drawDots( QPainter *painter,
     if ( !d_data->colorRange.isValid() )
         return;
 
+    if ( ( d_data->paintAttributes & ImageBuffer )
+        && d_data->penWidth <= 1.0 && QwtPainter::isAligning( painter ) )
+    {
+        drawImageBuffer( painter, xMap, yMap, canvasRect, from, to );
+        return;
+    }
+
+    if ( d_data->paintAttributes & ColorBuckets )
+    {
+        drawColorBuckets( painter, xMap, yMap, canvasRect, from, to );
+        return;
+    }
+
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
     const QwtColorMap::Format format = d_data->colorMap->format();
@@ -319,3 +391,144 @@ void QwtPlotSpectroCurve::drawDots( QPainter *painter,
 
     d_data->colorTable.clear();
 }
+
+/*!
+  Draw a subset of the points grouped by their colors
+
+  The points are mapped and sorted into buckets for the 256 colors
+  of QwtColorMap::colorTable256(). Then each bucket is painted with
+  one call of QPainter::drawPoints().
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rectangle of the canvas
+  \param from Index of the first sample to be painted
+  \param to Index of the last sample to be painted
+
+  \sa ColorBuckets, drawDots()
+*/
+void QwtPlotSpectroCurve::drawColorBuckets( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, int from, int to ) const
+{
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+    const bool doClip = d_data->paintAttributes & ClipPoints;
+
+    const QVector<QRgb> colorTable = d_data->colorMap->colorTable256();
+
+    QVector<QPolygonF> buckets( colorTable.size() );
+
+    const QwtSeriesData<QwtPoint3D> *series = data();
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtPoint3D sample = series->sample( i );
+
+        double xi = xMap.transform( sample.x() );
+        double yi = yMap.transform( sample.y() );
+        if ( doAlign )
+        {
+            xi = qRound( xi );
+            yi = qRound( yi );
+        }
+
+        if ( doClip && !canvasRect.contains( xi, yi ) )
+            continue;
+
+        const uint index = d_data->colorMap->colorIndex(
+            256, d_data->colorRange, sample.z() );
+
+        buckets[ qMin( index, 255u ) ] += QPointF( xi, yi );
+    }
+
+    for ( int i = 0; i < buckets.size(); i++ )
+    {
+        const QPolygonF &points = buckets[i];
+        if ( !points.isEmpty() )
+        {
+            painter->setPen( QPen( QColor::fromRgba( colorTable[i] ),
+                d_data->penWidth ) );
+
+            QwtPainter::drawPoints( painter, points );
+        }
+    }
+}
+
+/*!
+  Draw a subset of the points into a temporary image
+
+  The colored pixels are set by renderThreadCount() threads,
+  each of them processing a chunk of the points.
+  The image is painted to the canvas afterwards.
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rectangle of the canvas
+  \param from Index of the first sample to be painted
+  \param to Index of the last sample to be painted
+
+  \sa ImageBuffer, drawDots(), QwtPointMapper::toImage()
+*/
+void QwtPlotSpectroCurve::drawImageBuffer( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, int from, int to ) const
+{
+    const QRect rect = canvasRect.toAlignedRect();
+    if ( rect.isEmpty() )
+        return;
+
+    QImage image( rect.size(), QImage::Format_ARGB32 );
+    image.fill( Qt::transparent );
+
+    QVector<QRgb> colorTable;
+    if ( d_data->colorMap->format() == QwtColorMap::Indexed
+        || ( d_data->paintAttributes & ColorBuckets ) )
+    {
+        colorTable = d_data->colorMap->colorTable256();
+    }
+
+    QwtSpectroDotsCommand command;
+    command.series = data();
+    command.colorMap = d_data->colorMap;
+    command.colorRange = d_data->colorRange;
+    command.colorTable = colorTable.isEmpty() ? NULL : colorTable.constData();
+
+    uint numThreads = 1;
+#if !defined(QT_NO_QFUTURE)
+    numThreads = renderThreadCount();
+
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    if ( numThreads <= 0 )
+        numThreads = 1;
+#endif
+
+    const int numPoints = ( to - from + 1 ) / numThreads;
+
+#if !defined(QT_NO_QFUTURE)
+    QList< QFuture<void> > futures;
+    for ( uint i = 0; i < numThreads - 1; i++ )
+    {
+        command.from = from + i * numPoints;
+        command.to = command.from + numPoints - 1;
+
+        futures += QtConcurrent::run( &qwtRenderDots,
+            xMap, yMap, command, rect.topLeft(), &image );
+    }
+#endif
+
+    command.from = from + ( numThreads - 1 ) * numPoints;
+    command.to = to;
+
+    qwtRenderDots( xMap, yMap, command, rect.topLeft(), &image );
+
+#if !defined(QT_NO_QFUTURE)
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+
+    painter->drawImage( rect, image );
+}
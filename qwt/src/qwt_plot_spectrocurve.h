@@ -29,7 +29,29 @@ public:
     enum PaintAttribute
     {
         //! Clip points outside the canvas rectangle
-        ClipPoints = 1
+        ClipPoints = 1,
+
+        /*!
+          Group the points by the index of their color in the
+          table of 256 colors of the color map and paint each group
+          with one call of QPainter::drawPoints().
+
+          Avoids changing the pen for each point, but the colors
+          of color maps with QwtColorMap::RGB format are reduced
+          to 256 and the order of overlapping dots changes.
+         */
+        ColorBuckets = 2,
+
+        /*!
+          Set the colored pixels of the dots in a temporary image,
+          that is painted to the canvas. The points are distributed
+          to renderThreadCount() threads.
+
+          This is a very special optimization for a huge amount of
+          dots, that are drawn with a pen width <= 1 on a raster device.
+          In all other situations ImageBuffer is ignored.
+         */
+        ImageBuffer = 4
     };
 
     //! Paint attributes
@@ -67,6 +89,14 @@ protected:
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect, int from, int to ) const;
 
+    void drawColorBuckets( QPainter *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, int from, int to ) const;
+
+    void drawImageBuffer( QPainter *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, int from, int to ) const;
+
 private:
     void init();
 
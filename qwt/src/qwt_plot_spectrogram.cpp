@@ -89,6 +89,13 @@ public:
 
     int maxRGBColorTableSize;
     QVector<QRgb> colorTable;
+
+    struct ContourCache
+    {
+        QRectF area;
+        QSize raster;
+        QVector<double> values;
+    } contourCache;
 };
 
 /*!
@@ -373,6 +380,8 @@ void QwtPlotSpectrogram::setData( QwtRasterData *data )
         d_data->data = data;
 
         invalidateCache();
+        invalidateValueCache();
+
         itemChanged();
     }
 }
@@ -395,6 +404,20 @@ QwtRasterData *QwtPlotSpectrogram::data()
     return d_data->data;
 }
 
+/*!
+   Invalidate the cached values of the image and the contour lines
+
+   \sa QwtPlotRasterItem::CacheValues
+*/
+void QwtPlotSpectrogram::invalidateValueCache()
+{
+    QwtPlotRasterItem::invalidateValueCache();
+
+    d_data->contourCache.values = QVector<double>();
+    d_data->contourCache.area = QRectF();
+    d_data->contourCache.raster = QSize();
+}
+
 /*!
    \return Bounding interval for an axis
 
@@ -474,55 +497,115 @@ QImage QwtPlotSpectrogram::renderImage(
     if ( d_data->colorMap->format() == QwtColorMap::Indexed )
         image.setColorTable( d_data->colorMap->colorTable256() );
 
-    d_data->data->initRaster( area, image.size() );
-
 #if DEBUG_RENDER
     QElapsedTimer time;
     time.start();
 #endif
 
+    uint numThreads = 1;
 #if !defined(QT_NO_QFUTURE)
-    uint numThreads = renderThreadCount();
+    numThreads = renderThreadCount();
 
     if ( numThreads <= 0 )
         numThreads = QThread::idealThreadCount();
 
     if ( numThreads <= 0 )
         numThreads = 1;
+#endif
 
     const int numRows = imageSize.height() / numThreads;
 
-    QList< QFuture<void> > futures;
+    QVector<QRect> tiles( numThreads );
     for ( uint i = 0; i < numThreads; i++ )
     {
-        QRect tile( 0, i * numRows, image.width(), numRows );
+        QRect &tile = tiles[i];
+
+        tile.setRect( 0, i * numRows, image.width(), numRows );
         if ( i == numThreads - 1 )
-        {
             tile.setHeight( image.height() - i * numRows );
-            renderTile( xMap, yMap, tile, &image );
+    }
+
+    if ( testPaintAttribute( QwtPlotRasterItem::CacheValues ) )
+    {
+        /*
+            Sampling the values is usually the expensive part,
+            while mapping them into colors is cheap. So we keep
+            the values to avoid resampling, when only the color map
+            or the alpha value has been changed.
+         */
+        QVector<double> values;
+        if ( !cachedValues( xMap, yMap, area, imageSize, values ) )
+        {
+            values.resize( imageSize.width() * imageSize.height() );
+            double *v = values.data();
+
+            d_data->data->initRaster( area, image.size() );
+
+#if !defined(QT_NO_QFUTURE)
+            QList< QFuture<void> > futures;
+            for ( int i = 0; i < tiles.size() - 1; i++ )
+            {
+                futures += QtConcurrent::run(
+                    this, &QwtPlotSpectrogram::sampleTile,
+                    xMap, yMap, tiles[i], image.width(), v );
+            }
+            sampleTile( xMap, yMap, tiles.last(), image.width(), v );
+
+            for ( int i = 0; i < futures.size(); i++ )
+                futures[i].waitForFinished();
+#else
+            sampleTile( xMap, yMap, tiles[0], image.width(), v );
+#endif
+            d_data->data->discardRaster();
+
+            setCachedValues( xMap, yMap, area, imageSize, values );
         }
-        else
+
+        const double *v = values.constData();
+
+#if !defined(QT_NO_QFUTURE)
+        QList< QFuture<void> > futures;
+        for ( int i = 0; i < tiles.size() - 1; i++ )
         {
             futures += QtConcurrent::run(
-                this, &QwtPlotSpectrogram::renderTile,
-                xMap, yMap, tile, &image );
+                this, &QwtPlotSpectrogram::colorizeTile,
+                tiles[i], v, &image );
         }
+        colorizeTile( tiles.last(), v, &image );
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+#else
+        colorizeTile( tiles[0], v, &image );
+#endif
     }
-    for ( int i = 0; i < futures.size(); i++ )
-        futures[i].waitForFinished();
+    else
+    {
+        d_data->data->initRaster( area, image.size() );
+
+#if !defined(QT_NO_QFUTURE)
+        QList< QFuture<void> > futures;
+        for ( int i = 0; i < tiles.size() - 1; i++ )
+        {
+            futures += QtConcurrent::run(
+                this, &QwtPlotSpectrogram::renderTile,
+                xMap, yMap, tiles[i], &image );
+        }
+        renderTile( xMap, yMap, tiles.last(), &image );
 
-#else 
-    const QRect tile( 0, 0, image.width(), image.height() );
-    renderTile( xMap, yMap, tile, &image );
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+#else
+        renderTile( xMap, yMap, tiles[0], &image );
 #endif
+        d_data->data->discardRaster();
+    }
 
 #if DEBUG_RENDER
     const qint64 elapsed = time.elapsed();
     qDebug() << "renderImage" << imageSize << elapsed;
 #endif
 
-    d_data->data->discardRaster();
-
     return image;
 }
 
@@ -553,6 +636,32 @@ void QwtPlotSpectrogram::renderTile(
         const QRgb *rgbTable = d_data->colorTable.constData();
         const QwtColorMap *colorMap = d_data->colorMap;
 
+        if ( numColors == 0 )
+        {
+            /*
+                Sampling and colorizing are separated, so that
+                the color map can map a complete row at once
+             */
+            QVector<double> values( tile.width() );
+            double *v = values.data();
+
+            for ( int y = tile.top(); y <= tile.bottom(); y++ )
+            {
+                const double ty = yMap.invTransform( y );
+
+                for ( int x = tile.left(); x <= tile.right(); x++ )
+                {
+                    const double tx = xMap.invTransform( x );
+                    v[x - tile.left()] = d_data->data->value( tx, ty );
+                }
+
+                QRgb *line = reinterpret_cast<QRgb *>( image->scanLine( y ) );
+                colorMap->rgbRow( range, v, tile.width(), line + tile.left() );
+            }
+
+            return;
+        }
+
         for ( int y = tile.top(); y <= tile.bottom(); y++ )
         {
             const double ty = yMap.invTransform( y );
@@ -570,10 +679,6 @@ void QwtPlotSpectrogram::renderTile(
                 {
                     *line++ = 0u;
                 }
-                else if ( numColors == 0 )
-                {
-                    *line++ = colorMap->rgb( range, value );
-                }
                 else
                 {
                     const uint index = colorMap->colorIndex( numColors, range, value );
@@ -611,6 +716,110 @@ void QwtPlotSpectrogram::renderTile(
     }
 }
 
+/*!
+    \brief Sample the values of a tile
+
+    \param xMap X-Scale Map
+    \param yMap Y-Scale Map
+    \param tile Geometry of the tile in image coordinates
+    \param stride Number of values per row
+    \param values Values of the complete image in row major order
+
+    \sa colorizeTile(), QwtPlotRasterItem::CacheValues
+*/
+void QwtPlotSpectrogram::sampleTile(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRect &tile, int stride, double *values ) const
+{
+    for ( int y = tile.top(); y <= tile.bottom(); y++ )
+    {
+        const double ty = yMap.invTransform( y );
+
+        double *line = values + y * stride + tile.left();
+
+        for ( int x = tile.left(); x <= tile.right(); x++ )
+        {
+            const double tx = xMap.invTransform( x );
+            *line++ = d_data->data->value( tx, ty );
+        }
+    }
+}
+
+/*!
+    \brief Map the sampled values of a tile into colors
+
+    \param tile Geometry of the tile in image coordinates
+    \param values Values of the complete image in row major order
+    \param image Image to be rendered
+
+    \sa sampleTile(), QwtPlotRasterItem::CacheValues
+*/
+void QwtPlotSpectrogram::colorizeTile( const QRect &tile,
+    const double *values, QImage *image ) const
+{
+    const QwtInterval range = d_data->data->interval( Qt::ZAxis );
+    if ( range.width() <= 0.0 )
+        return;
+
+    const bool hasGaps = !d_data->data->testAttribute( QwtRasterData::WithoutGaps );
+    const QwtColorMap *colorMap = d_data->colorMap;
+
+    const int stride = image->width();
+
+    for ( int y = tile.top(); y <= tile.bottom(); y++ )
+    {
+        const double *r = values + y * stride + tile.left();
+
+        if ( colorMap->format() == QwtColorMap::RGB )
+        {
+            const int numColors = d_data->colorTable.size();
+            const QRgb *rgbTable = d_data->colorTable.constData();
+
+            QRgb *line = reinterpret_cast<QRgb *>( image->scanLine( y ) );
+            line += tile.left();
+
+            if ( numColors == 0 )
+            {
+                colorMap->rgbRow( range, r, tile.width(), line );
+            }
+            else
+            {
+                for ( int i = 0; i < tile.width(); i++ )
+                {
+                    if ( hasGaps && qwtIsNaN( r[i] ) )
+                    {
+                        line[i] = 0u;
+                    }
+                    else
+                    {
+                        const uint index = 
+                            colorMap->colorIndex( numColors, range, r[i] );
+                        line[i] = rgbTable[index];
+                    }
+                }
+            }
+        }
+        else if ( colorMap->format() == QwtColorMap::Indexed )
+        {
+            unsigned char *line = image->scanLine( y );
+            line += tile.left();
+
+            for ( int i = 0; i < tile.width(); i++ )
+            {
+                if ( hasGaps && qwtIsNaN( r[i] ) )
+                {
+                    line[i] = 0;
+                }
+                else
+                {
+                    const uint index = colorMap->colorIndex( 256, range, r[i] );
+                    line[i] = static_cast<unsigned char>( index );
+                }
+            }
+        }
+    }
+}
+
 /*!
    \brief Return the raster to be used by the CONREC contour algorithm.
 
@@ -660,6 +869,22 @@ QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
     if ( d_data->data == NULL )
         return QwtRasterData::ContourLines();
 
+    if ( testPaintAttribute( QwtPlotRasterItem::CacheValues ) )
+    {
+        // changing the contour levels doesn't need to resample the data
+
+        PrivateData::ContourCache &cache = d_data->contourCache;
+        if ( cache.values.isEmpty() || cache.area != rect || cache.raster != raster )
+        {
+            cache.area = rect;
+            cache.raster = raster;
+            cache.values = d_data->data->contourRaster( rect, raster );
+        }
+
+        return d_data->data->conrec( rect, raster, cache.values,
+            d_data->contourLevels, d_data->conrecFlags );
+    }
+
     return d_data->data->contourLines( rect, raster,
         d_data->contourLevels, d_data->conrecFlags );
 }
@@ -747,6 +972,18 @@ void QwtPlotSpectrogram::draw( QPainter *painter,
 
         QSize raster = contourRasterSize( area, rasterRect.toRect() );
         raster = raster.boundedTo( rasterRect.toRect().size() );
+
+        const double pixelSize = QwtPainter::vectorPixelSize( painter );
+        if ( pixelSize > 1.0 )
+        {
+            // no need for a raster, that is finer than
+            // the vector resolution of a PDF/SVG document
+
+            const QSize maxRaster( qCeil( rasterRect.width() / pixelSize ),
+                qCeil( rasterRect.height() / pixelSize ) );
+            raster = raster.boundedTo( maxRaster );
+        }
+
         if ( raster.isValid() )
         {
             const QwtRasterData::ContourLines lines =
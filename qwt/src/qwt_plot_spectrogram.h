@@ -74,6 +74,8 @@ public:
     virtual QwtInterval interval(Qt::Axis) const;
     virtual QRectF pixelHint( const QRectF & ) const;
 
+    virtual void invalidateValueCache();
+
     void setDefaultContourPen( const QColor &, 
         qreal width = 0.0, Qt::PenStyle = Qt::SolidLine );
     void setDefaultContourPen( const QPen & );
@@ -112,6 +114,12 @@ protected:
         const QRect &imageRect, QImage *image ) const;
 
 private:
+    void sampleTile( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRect &tile, int stride, double *values ) const;
+
+    void colorizeTile( const QRect &tile, 
+        const double *values, QImage *image ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
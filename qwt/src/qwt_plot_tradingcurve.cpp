@@ -11,7 +11,9 @@
 #include "qwt_scale_map.h"
 #include "qwt_clipper.h"
 #include "qwt_painter.h"
+#include "qwt_math.h"
 #include <qpainter.h>
+#include <qnumeric.h>
 
 static inline bool qwtIsSampleInside( const QwtOHLCSample &sample,
     double tMin, double tMax, double vMin, double vMax )
@@ -25,6 +27,220 @@ static inline bool qwtIsSampleInside( const QwtOHLCSample &sample,
     return !isOffScreen;
 }
 
+// index of the first sample in [from, to] with a time >= t, or to + 1
+static int qwtLowerTimeIndex( const QwtSeriesData<QwtOHLCSample> *series,
+    int from, int to, double t )
+{
+    int lower = from;
+    int upper = to + 1;
+
+    while ( lower < upper )
+    {
+        const int mid = lower + ( upper - lower ) / 2;
+        if ( series->sample( mid ).time < t )
+            lower = mid + 1;
+        else
+            upper = mid;
+    }
+
+    return lower;
+}
+
+// index of the first sample in [from, to] with a time > t, or to + 1
+static int qwtUpperTimeIndex( const QwtSeriesData<QwtOHLCSample> *series,
+    int from, int to, double t )
+{
+    int lower = from;
+    int upper = to + 1;
+
+    while ( lower < upper )
+    {
+        const int mid = lower + ( upper - lower ) / 2;
+        if ( series->sample( mid ).time <= t )
+            lower = mid + 1;
+        else
+            upper = mid;
+    }
+
+    return lower;
+}
+
+static inline QwtOHLCSample qwtTranslatedSample( const QwtOHLCSample &sample,
+    const QwtScaleMap *timeMap, const QwtScaleMap *valueMap, bool doAlign )
+{
+    QwtOHLCSample translatedSample;
+
+    translatedSample.time = timeMap->transform( sample.time );
+    translatedSample.open = valueMap->transform( sample.open );
+    translatedSample.high = valueMap->transform( sample.high );
+    translatedSample.low = valueMap->transform( sample.low );
+    translatedSample.close = valueMap->transform( sample.close );
+
+    if ( doAlign )
+    {
+        translatedSample.time = qRound( translatedSample.time );
+        translatedSample.open = qRound( translatedSample.open );
+        translatedSample.high = qRound( translatedSample.high );
+        translatedSample.low = qRound( translatedSample.low );
+        translatedSample.close = qRound( translatedSample.close );
+    }
+
+    return translatedSample;
+}
+
+namespace
+{
+    /*
+      The minimum of the low and the maximum of the high prices
+      for blocks of Fanout samples, Fanout^2 samples ...
+     */
+    class PriceTable
+    {
+    public:
+        enum { Fanout = 16 };
+
+        class Range
+        {
+        public:
+            Range():
+                low( qInf() ),
+                high( -qInf() )
+            {
+            }
+
+            inline void unite( double l, double h )
+            {
+                if ( l < low )
+                    low = l;
+
+                if ( h > high )
+                    high = h;
+            }
+
+            inline void unite( const Range &other )
+            {
+                unite( other.low, other.high );
+            }
+
+            double low;
+            double high;
+        };
+
+        PriceTable():
+            d_numSamples( 0 )
+        {
+        }
+
+        void reset()
+        {
+            d_levels.clear();
+            d_numSamples = 0;
+        }
+
+        void update( const QwtSeriesData<QwtOHLCSample> *series )
+        {
+            const int numSamples = static_cast<int>( series->size() );
+            if ( numSamples < d_numSamples )
+                reset();
+
+            /*
+              Samples might have been appended or the last sample
+              might have been modified ( f.e. the current candle
+              of a live feed ), without changing the size. So the
+              block of the last known sample and all blocks behind
+              it are always recalculated - including their ancestors.
+             */
+
+            int from = qMax( d_numSamples - 1, 0 );
+            int count = numSamples;
+
+            for ( int level = 0; count > 1; level++ )
+            {
+                if ( level >= d_levels.size() )
+                    d_levels += QVector<Range>();
+
+                const int numBlocks = ( count + Fanout - 1 ) / Fanout;
+
+                QVector<Range> &blocks = d_levels[level];
+                blocks.resize( numBlocks );
+
+                const int firstBlock = from / Fanout;
+                for ( int i = firstBlock; i < numBlocks; i++ )
+                {
+                    const int i1 = i * Fanout;
+                    const int i2 = qMin( i1 + Fanout, count ) - 1;
+
+                    Range range;
+                    for ( int j = i1; j <= i2; j++ )
+                        range.unite( entry( series, level - 1, j ) );
+
+                    blocks[i] = range;
+                }
+
+                from = firstBlock;
+                count = numBlocks;
+            }
+
+            d_numSamples = numSamples;
+        }
+
+        Range range( const QwtSeriesData<QwtOHLCSample> *series,
+            int from, int to ) const
+        {
+            Range range;
+
+            int level = -1; // the samples
+
+            while ( from <= to )
+            {
+                if ( to - from + 1 < Fanout || level + 1 >= d_levels.size() )
+                {
+                    for ( int i = from; i <= to; i++ )
+                        range.unite( entry( series, level, i ) );
+
+                    break;
+                }
+
+                // entries that are not aligned to the blocks
+                // of the next level
+
+                while ( from % Fanout )
+                    range.unite( entry( series, level, from++ ) );
+
+                while ( ( to + 1 ) % Fanout )
+                    range.unite( entry( series, level, to-- ) );
+
+                from /= Fanout;
+                to = ( to + 1 ) / Fanout - 1;
+
+                level++;
+            }
+
+            return range;
+        }
+
+    private:
+        inline Range entry( const QwtSeriesData<QwtOHLCSample> *series,
+            int level, int index ) const
+        {
+            if ( level < 0 )
+            {
+                const QwtOHLCSample sample = series->sample( index );
+
+                Range range;
+                range.unite( sample.low, sample.high );
+
+                return range;
+            }
+
+            return d_levels[level][index];
+        }
+
+        QVector< QVector<Range> > d_levels;
+        int d_numSamples;
+    };
+}
+
 class QwtPlotTradingCurve::PrivateData
 {
 public:
@@ -48,6 +264,8 @@ public:
     QBrush symbolBrush[2]; // Increasing/Decreasing
 
     QwtPlotTradingCurve::PaintAttributes paintAttributes;
+
+    PriceTable priceTable;
 };
 
 /*!
@@ -409,7 +627,7 @@ void QwtPlotTradingCurve::drawSeries( QPainter *painter,
   \param from Index of the first point to be painted
   \param to Index of the last point to be painted
 
-  \sa drawSeries()
+  \sa drawSeries(), AggregateSymbols
 */
 void QwtPlotTradingCurve::drawSymbols( QPainter *painter,
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
@@ -455,57 +673,106 @@ void QwtPlotTradingCurve::drawSymbols( QPainter *painter,
 
     painter->setPen( pen );
 
+    if ( d_data->paintAttributes & AggregateSymbols )
+    {
+        const QwtSeriesData<QwtOHLCSample> *series = data();
+        d_data->priceTable.update( series );
+
+        from = qwtLowerTimeIndex( series, from, to, tMin );
+        to = qwtUpperTimeIndex( series, from, to, tMax ) - 1;
+
+        // a symbol and a gap of the same width
+        const double pitch = qMax( 2.0 * symbolWidth, 1.0 );
+
+        const double p0 = timeMap->transform( tMin );
+        const double sign = ( timeMap->transform( tMax ) < p0 ) ? -1.0 : 1.0;
+
+        int i = from;
+        while ( i <= to )
+        {
+            QwtOHLCSample s = series->sample( i );
+
+            const int bucket = qFloor(
+                sign * ( timeMap->transform( s.time ) - p0 ) / pitch );
+
+            const double tEnd = timeMap->invTransform(
+                p0 + sign * ( bucket + 1 ) * pitch );
+
+            const int last = qMax( i,
+                qwtLowerTimeIndex( series, i + 1, to, tEnd ) - 1 );
+
+            if ( last > i )
+            {
+                const PriceTable::Range range =
+                    d_data->priceTable.range( series, i, last );
+
+                s.time = timeMap->invTransform(
+                    p0 + sign * ( bucket + 0.5 ) * pitch );
+                s.close = series->sample( last ).close;
+                s.low = range.low;
+                s.high = range.high;
+            }
+
+            if ( !doClip || qwtIsSampleInside( s, tMin, tMax, vMin, vMax ) )
+            {
+                const Direction direction = ( s.open < s.close )
+                    ? QwtPlotTradingCurve::Increasing
+                    : QwtPlotTradingCurve::Decreasing;
+
+                drawTranslatedSymbol( painter,
+                    qwtTranslatedSample( s, timeMap, valueMap, doAlign ),
+                    direction, orient, inverted, symbolWidth );
+            }
+
+            i = last + 1;
+        }
+
+        return;
+    }
+
     for ( int i = from; i <= to; i++ )
     {
         const QwtOHLCSample s = sample( i );
 
         if ( !doClip || qwtIsSampleInside( s, tMin, tMax, vMin, vMax ) )
         {
-            QwtOHLCSample translatedSample;
-
-            translatedSample.time = timeMap->transform( s.time );
-            translatedSample.open = valueMap->transform( s.open );
-            translatedSample.high = valueMap->transform( s.high );
-            translatedSample.low = valueMap->transform( s.low );
-            translatedSample.close = valueMap->transform( s.close );
-
-            const int brushIndex = ( s.open < s.close )
+            const Direction direction = ( s.open < s.close )
                 ? QwtPlotTradingCurve::Increasing
                 : QwtPlotTradingCurve::Decreasing;
 
-            if ( doAlign )
-            {
-                translatedSample.time = qRound( translatedSample.time );
-                translatedSample.open = qRound( translatedSample.open );
-                translatedSample.high = qRound( translatedSample.high );
-                translatedSample.low = qRound( translatedSample.low );
-                translatedSample.close = qRound( translatedSample.close );
-            }
+            drawTranslatedSymbol( painter,
+                qwtTranslatedSample( s, timeMap, valueMap, doAlign ),
+                direction, orient, inverted, symbolWidth );
+        }
+    }
+}
 
-            switch( d_data->symbolStyle )
+void QwtPlotTradingCurve::drawTranslatedSymbol( QPainter *painter,
+    const QwtOHLCSample &translatedSample, Direction direction,
+    Qt::Orientation orient, bool inverted, double symbolWidth ) const
+{
+    switch( d_data->symbolStyle )
+    {
+        case Bar:
+        {
+            drawBar( painter, translatedSample,
+                orient, inverted, symbolWidth );
+            break;
+        }
+        case CandleStick:
+        {
+            painter->setBrush( d_data->symbolBrush[ direction ] );
+            drawCandleStick( painter, translatedSample,
+                orient, symbolWidth );
+            break;
+        }
+        default:
+        {
+            if ( d_data->symbolStyle >= UserSymbol )
             {
-                case Bar:
-                {
-                    drawBar( painter, translatedSample, 
-                        orient, inverted, symbolWidth );
-                    break;
-                }
-                case CandleStick:
-                {
-                    painter->setBrush( d_data->symbolBrush[ brushIndex ] );
-                    drawCandleStick( painter, translatedSample, 
-                        orient, symbolWidth );
-                    break;
-                }
-                default:
-                {
-                    if ( d_data->symbolStyle >= UserSymbol )
-                    {
-                        painter->setBrush( d_data->symbolBrush[ brushIndex ] );
-                        drawUserSymbol( painter, d_data->symbolStyle,
-                            translatedSample, orient, inverted, symbolWidth );
-                    }
-                }
+                painter->setBrush( d_data->symbolBrush[ direction ] );
+                drawUserSymbol( painter, d_data->symbolStyle,
+                    translatedSample, orient, inverted, symbolWidth );
             }
         }
     }
@@ -640,6 +907,18 @@ QwtGraphic QwtPlotTradingCurve::legendIcon( int index,
     return defaultIcon( d_data->symbolPen.color(), size );
 }
 
+/*!
+  \brief Invalidate the table of minimum/maximum prices,
+         that is used for AggregateSymbols
+
+  \sa AggregateSymbols
+ */
+void QwtPlotTradingCurve::dataChanged()
+{
+    d_data->priceTable.reset();
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
   Calculate the symbol width in paint coordinates
 
@@ -95,7 +95,28 @@ public:
     enum PaintAttribute
     {
         //! Check if a symbol is on the plot canvas before painting it.
-        ClipSymbols   = 0x01
+        ClipSymbols   = 0x01,
+
+        /*!
+          Aggregate the samples on the fly into buckets, so that
+          the distance between the symbols is at least twice the
+          symbol width. The symbol of a bucket displays the open price
+          of its first, the close price of its last, the maximum of
+          the high and the minimum of the low prices of all its samples.
+
+          The minimum/maximum of the prices are looked up in a
+          multi-level table, that is built from the samples the first
+          time it is needed. So the effort for painting depends on
+          the number of visible symbols - not on the number of samples.
+          On each replot the blocks at the end of the table are
+          recalculated, so that appending samples or modifying the
+          last sample is handled. Any other modification of the
+          samples requires a call of dataChanged().
+
+          AggregateSymbols requires, that the samples are
+          ordered by time.
+         */
+        AggregateSymbols = 0x02
     };
 
     //! Paint attributes
@@ -164,7 +185,12 @@ protected:
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect ) const;
 
+    virtual void dataChanged();
+
 private:
+    void drawTranslatedSymbol( QPainter *, const QwtOHLCSample &,
+        Direction, Qt::Orientation, bool inverted, double width ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
@@ -147,7 +147,10 @@ void QwtPlotZoomer::init( bool doReplot )
     setStateMachine( new QwtPickerDragRectMachine() );
 
     if ( doReplot && plot() )
+    {
         plot()->replot();
+        plot()->flushReplot();
+    }
 
     setZoomBase( scaleRect() );
 }
@@ -236,7 +239,10 @@ void QwtPlotZoomer::setZoomBase( bool doReplot )
         return;
 
     if ( doReplot )
+    {
         plt->replot();
+        plt->flushReplot();
+    }
 
     d_data->zoomStack.clear();
     d_data->zoomStack.push( scaleRect() );
@@ -525,15 +525,48 @@ static inline QPolygonF qwtToPointsFilteredF(
         boundingRect, xMap, yMap, series, from, to );
 }
 
+// Mapping points to a grid of cells, where each cell has
+// the size of a pixel at the resolution of the mapper
+
+static inline QwtScaleMap qwtGridMap(
+    const QwtScaleMap &map, double resolution )
+{
+    QwtScaleMap gridMap = map;
+    gridMap.setPaintInterval(
+        map.p1() / resolution, map.p2() / resolution );
+
+    return gridMap;
+}
+
+static QPolygonF qwtFromGrid( const QPolygon &polygon, double resolution )
+{
+    const int numPoints = polygon.size();
+
+    QPolygonF polygonF( numPoints );
+
+    const QPoint *points = polygon.constData();
+    QPointF *pointsF = polygonF.data();
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        pointsF[i].rx() = points[i].x() * resolution;
+        pointsF[i].ry() = points[i].y() * resolution;
+    }
+
+    return polygonF;
+}
+
 class QwtPointMapper::PrivateData
 {
 public:
     PrivateData():
-        boundingRect( qwtInvalidRect )
+        boundingRect( qwtInvalidRect ),
+        resolution( 0.0 )
     {
     }
 
     QRectF boundingRect;
+    double resolution;
     QwtPointMapper::TransformationFlags flags;
 };
 
@@ -617,6 +650,37 @@ QRectF QwtPointMapper::boundingRect() const
     return d_data->boundingRect;
 }
 
+/*!
+  \brief Set the size of a pixel for mapping without rounding
+
+  When RoundPoints is not set, but WeedOutPoints is enabled and the
+  resolution is > 0.0, points are mapped to a grid of cells of this size.
+  This way the output for paint devices, that don't floor to integers
+  ( PDF, SVG ) can be reduced like for raster devices:
+
+  - toPolygonF() reduces each chunk of points in the same cell column
+    ( or row ) like WeedOutIntermediatePoints
+  - toPointsF() removes all points, that are mapped to the same cell
+
+  The default setting is 0.0, what disables the grid.
+
+  \param resolution Size of a cell in paint device coordinates
+  \sa resolution(), QwtPainter::vectorPixelSize()
+ */
+void QwtPointMapper::setResolution( double resolution )
+{
+    d_data->resolution = qMax( resolution, 0.0 );
+}
+
+/*!
+  \return Size of a pixel for mapping without rounding
+  \sa setResolution()
+ */
+double QwtPointMapper::resolution() const
+{
+    return d_data->resolution;
+}
+
 /*!
   \brief Translate a series of points into a QPolygonF
 
@@ -630,6 +694,10 @@ QRectF QwtPointMapper::boundingRect() const
   When RoundPoints & WeedOutIntermediatePoints is enabled an even more
   aggressive weeding algorithm is enabled.
 
+  When WeedOutPoints is enabled without RoundPoints and a resolution()
+  has been set, the same algorithm is applied to a grid of cells
+  of this size.
+
   \param xMap x map
   \param yMap y map
   \param series Series of points to be mapped
@@ -664,7 +732,17 @@ QPolygonF QwtPointMapper::toPolygonF(
     }
     else
     {
-        if ( d_data->flags & WeedOutPoints )
+        if ( ( d_data->flags & WeedOutPoints ) && d_data->resolution > 0.0 )
+        {
+            const double res = d_data->resolution;
+
+            const QPolygon gridPolyline = qwtMapPointsQuad<QPolygon, QPoint>(
+                qwtGridMap( xMap, res ), qwtGridMap( yMap, res ),
+                series, from, to );
+
+            polyline = qwtFromGrid( gridPolyline, res );
+        }
+        else if ( d_data->flags & WeedOutPoints )
         {
             polyline = qwtToPolylineFilteredF( 
                 xMap, yMap, series, from, to, QwtNoRoundF() );
@@ -775,6 +853,20 @@ QPolygonF QwtPointMapper::toPointsF(
                     xMap, yMap, series, from, to, QwtRoundF() );
             }
         }
+        else if ( d_data->resolution > 0.0 && d_data->boundingRect.isValid() )
+        {
+            // filtering duplicates in a grid of cells instead of pixels
+
+            const double res = d_data->resolution;
+
+            const QRectF &br = d_data->boundingRect;
+            const QRectF gridRect( br.x() / res, br.y() / res, 
+                br.width() / res, br.height() / res );
+
+            points = qwtFromGrid( qwtToPointsFilteredI( gridRect,
+                qwtGridMap( xMap, res ), qwtGridMap( yMap, res ),
+                series, from, to ), res );
+        }
         else
         {
             // when rounding is not allowed we can't use
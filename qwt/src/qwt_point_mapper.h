@@ -83,6 +83,9 @@ public:
     void setBoundingRect( const QRectF & );
     QRectF boundingRect() const;
 
+    void setResolution( double );
+    double resolution() const;
+
     QPolygonF toPolygonF( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to ) const;
 
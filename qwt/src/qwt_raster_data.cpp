@@ -267,6 +267,9 @@ QRectF QwtRasterData::pixelHint( const QRectF &area ) const
 /*!
    Calculate contour lines
 
+   The default implementation samples the values at the vertices of
+   the raster using contourRaster() and passes them to conrec().
+
    \param rect Bounding rectangle for the contour lines
    \param raster Number of data pixels of the raster data
    \param levels List of limits, where to insert contour lines
@@ -274,18 +277,95 @@ QRectF QwtRasterData::pixelHint( const QRectF &area ) const
 
    \return Calculated contour lines
 
-   An adaption of CONREC, a simple contouring algorithm.
-   http://local.wasp.uwa.edu.au/~pbourke/papers/conrec/
+   \sa contourRaster(), conrec()
 */
 QwtRasterData::ContourLines QwtRasterData::contourLines(
     const QRectF &rect, const QSize &raster,
     const QList<double> &levels, ConrecFlags flags ) const
+{
+    if ( levels.size() == 0 || !rect.isValid() || !raster.isValid() )
+        return ContourLines();
+
+    return conrec( rect, raster, 
+        contourRaster( rect, raster ), levels, flags );
+}
+
+/*!
+   \brief Sample the values at the vertices of a contour raster
+
+   The vertex ( x, y ) of the raster is located at
+   ( rect.x() + x * rect.width() / raster.width(),
+     rect.y() + y * rect.height() / raster.height() ).
+
+   As the values don't depend on the contour levels, they can be
+   reused by conrec() for different sets of levels.
+
+   \param rect Bounding rectangle for the contour lines
+   \param raster Number of data pixels of the raster data
+
+   \return Values in row major order: values[ y * raster.width() + x ]
+   \sa conrec(), value(), initRaster(), discardRaster()
+*/
+QVector<double> QwtRasterData::contourRaster( 
+    const QRectF &rect, const QSize &raster ) const
+{
+    QVector<double> values;
+    if ( !rect.isValid() || !raster.isValid() )
+        return values;
+
+    const int w = raster.width();
+    const int h = raster.height();
+
+    const double dx = rect.width() / w;
+    const double dy = rect.height() / h;
+
+    values.resize( w * h );
+    double *v = values.data();
+
+    QwtRasterData *that = const_cast<QwtRasterData *>( this );
+    that->initRaster( rect, raster );
+
+    for ( int y = 0; y < h; y++ )
+    {
+        const double ty = rect.y() + y * dy;
+
+        for ( int x = 0; x < w; x++ )
+            *v++ = value( rect.x() + x * dx, ty );
+    }
+
+    that->discardRaster();
+
+    return values;
+}
+
+/*!
+   Calculate contour lines from sampled values
+
+   An adaption of CONREC, a simple contouring algorithm.
+   http://local.wasp.uwa.edu.au/~pbourke/papers/conrec/
+
+   \param rect Bounding rectangle for the contour lines
+   \param raster Number of data pixels of the raster data
+   \param values Values at the vertices of the raster, as
+                 returned from contourRaster()
+   \param levels List of limits, where to insert contour lines
+   \param flags Flags to customize the contouring algorithm
+
+   \return Calculated contour lines
+   \sa contourRaster(), contourLines()
+*/
+QwtRasterData::ContourLines QwtRasterData::conrec(
+    const QRectF &rect, const QSize &raster, const QVector<double> &values,
+    const QList<double> &levels, ConrecFlags flags ) const
 {
     ContourLines contourLines;
 
     if ( levels.size() == 0 || !rect.isValid() || !raster.isValid() )
         return contourLines;
 
+    if ( values.size() != raster.width() * raster.height() )
+        return contourLines;
+
     const double dx = rect.width() / raster.width();
     const double dy = rect.height() / raster.height();
 
@@ -297,8 +377,7 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
     if ( range.isValid() )
         ignoreOutOfRange = flags & IgnoreOutOfRange;
 
-    QwtRasterData *that = const_cast<QwtRasterData *>( this );
-    that->initRaster( rect, raster );
+    const int stride = raster.width();
 
     for ( int y = 0; y < raster.height() - 1; y++ )
     {
@@ -316,6 +395,9 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
 
         QwtPoint3D xy[NumPositions];
 
+        const double *row0 = values.constData() + y * stride;
+        const double *row1 = row0 + stride;
+
         for ( int x = 0; x < raster.width() - 1; x++ )
         {
             const QPointF pos( rect.x() + x * dx, rect.y() + y * dy );
@@ -324,15 +406,11 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
             {
                 xy[TopRight].setX( pos.x() );
                 xy[TopRight].setY( pos.y() );
-                xy[TopRight].setZ(
-                    value( xy[TopRight].x(), xy[TopRight].y() )
-                );
+                xy[TopRight].setZ( row0[0] );
 
                 xy[BottomRight].setX( pos.x() );
                 xy[BottomRight].setY( pos.y() + dy );
-                xy[BottomRight].setZ(
-                    value( xy[BottomRight].x(), xy[BottomRight].y() )
-                );
+                xy[BottomRight].setZ( row1[0] );
             }
 
             xy[TopLeft] = xy[TopRight];
@@ -343,12 +421,8 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
             xy[BottomRight].setX( pos.x() + dx );
             xy[BottomRight].setY( pos.y() + dy );
 
-            xy[TopRight].setZ(
-                value( xy[TopRight].x(), xy[TopRight].y() )
-            );
-            xy[BottomRight].setZ(
-                value( xy[BottomRight].x(), xy[BottomRight].y() )
-            );
+            xy[TopRight].setZ( row0[x + 1] );
+            xy[BottomRight].setZ( row1[x + 1] );
 
             double zMin = xy[TopLeft].z();
             double zMax = zMin;
@@ -417,7 +491,5 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
         }
     }
 
-    that->discardRaster();
-
     return contourLines;
 }
@@ -15,6 +15,7 @@
 #include <qmap.h>
 #include <qlist.h>
 #include <qpolygon.h>
+#include <qvector.h>
 
 class QwtScaleMap;
 
@@ -113,6 +114,13 @@ public:
         const QSize &raster, const QList<double> &levels,
         ConrecFlags ) const;
 
+    QVector<double> contourRaster( 
+        const QRectF &rect, const QSize &raster ) const;
+
+    ContourLines conrec( const QRectF &rect, const QSize &raster, 
+        const QVector<double> &values, const QList<double> &levels,
+        ConrecFlags ) const;
+
     class Contour3DPoint;
     class ContourPlane;
 
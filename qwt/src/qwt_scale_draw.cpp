@@ -648,7 +648,7 @@ double QwtScaleDraw::length() const
 */
 void QwtScaleDraw::drawLabel( QPainter *painter, double value ) const
 {
-    QwtText lbl = tickLabel( painter->font(), value );
+    const QwtText &lbl = tickLabel( painter->font(), value );
     if ( lbl.isEmpty() )
         return;
 
@@ -661,7 +661,7 @@ void QwtScaleDraw::drawLabel( QPainter *painter, double value ) const
     painter->save();
     painter->setWorldTransform( transform, true );
 
-    lbl.draw ( painter, QRect( QPoint( 0, 0 ), labelSize.toSize() ) );
+    drawTickLabel( painter, value, QRect( QPoint( 0, 0 ), labelSize.toSize() ) );
 
     painter->restore();
 }
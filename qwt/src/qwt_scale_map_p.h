@@ -0,0 +1,48 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SCALE_MAP_P_H
+#define QWT_SCALE_MAP_P_H
+
+/*
+  This file is not part of the Qwt API. It is shared by
+  the implementations of items, that cache paint results
+  for a pair of scale maps, and is not installed.
+ */
+
+#include "qwt_scale_map.h"
+
+/*
+  Check if 2 maps transform all values to the same positions.
+  Needed for invalidating caches, when the scale engine of an
+  axis has been replaced without changing its interval.
+ */
+static inline bool qwtIsSameMap(
+    const QwtScaleMap &map1, const QwtScaleMap &map2 )
+{
+    if ( map1.s1() != map2.s1() || map1.s2() != map2.s2()
+        || map1.p1() != map2.p1() || map1.p2() != map2.p2() )
+    {
+        return false;
+    }
+
+    if ( ( map1.transformation() == NULL )
+        != ( map2.transformation() == NULL ) )
+    {
+        return false;
+    }
+
+    // the transformations are cloned, when copying a map,
+    // so we compare them by their results
+
+    const double s = 0.5 * ( map1.s1() + map1.s2() );
+    return map1.transform( s ) == map2.transform( s );
+}
+
+#endif
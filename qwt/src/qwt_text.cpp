@@ -20,6 +20,15 @@
 #include <qdesktopwidget.h>
 #include <qmath.h>
 
+static inline QPaintDevice *qwtMetricsDevice()
+{
+    QPaintDevice *device = QwtPainter::metricsDevice();
+    if ( device == NULL )
+        device = QApplication::desktop();
+
+    return device;
+}
+
 class QwtTextEngineDict
 {
 public:
@@ -170,6 +179,7 @@ public:
     }
 
     QFont font;
+    QSize resolution; // of the metrics device
     QSizeF textSize;
 };
 
@@ -489,10 +499,10 @@ bool QwtText::testLayoutAttribute( LayoutAttribute attribute ) const
 */
 double QwtText::heightForWidth( double width, const QFont &defaultFont ) const
 {
-    // We want to calculate in screen metrics. So
-    // we need a font that uses screen metrics
+    // We want to calculate in the metrics of the reference
+    // device - usually the screen. So we need a font that uses them
 
-    const QFont font( usedFont( defaultFont ), QApplication::desktop() );
+    const QFont font( usedFont( defaultFont ), qwtMetricsDevice() );
 
     double h = 0;
 
@@ -525,17 +535,24 @@ double QwtText::heightForWidth( double width, const QFont &defaultFont ) const
 */
 QSizeF QwtText::textSize( const QFont &defaultFont ) const
 {
-    // We want to calculate in screen metrics. So
-    // we need a font that uses screen metrics
+    // We want to calculate in the metrics of the reference
+    // device - usually the screen. So we need a font that uses them
+
+    QPaintDevice *metricsDevice = qwtMetricsDevice();
+    const QFont font( usedFont( defaultFont ), metricsDevice );
 
-    const QFont font( usedFont( defaultFont ), QApplication::desktop() );
+    // fonts for devices with different resolutions compare equal
+    const QSize resolution( metricsDevice->logicalDpiX(),
+        metricsDevice->logicalDpiY() );
 
     if ( !d_layoutCache->textSize.isValid()
-        || d_layoutCache->font != font )
+        || d_layoutCache->font != font
+        || d_layoutCache->resolution != resolution )
     {
         d_layoutCache->textSize = d_data->textEngine->textSize(
             font, d_data->renderFlags, d_data->text );
         d_layoutCache->font = font;
+        d_layoutCache->resolution = resolution;
     }
 
     QSizeF sz = d_layoutCache->textSize;
@@ -600,10 +617,10 @@ void QwtText::draw( QPainter *painter, const QRectF &rect ) const
     QRectF expandedRect = rect;
     if ( d_data->layoutAttributes & MinimumLayout )
     {
-        // We want to calculate in screen metrics. So
-        // we need a font that uses screen metrics
+        // We want to calculate in the metrics of the reference
+        // device - usually the screen. So we need a font that uses them
 
-        const QFont font( painter->font(), QApplication::desktop() );
+        const QFont font( painter->font(), qwtMetricsDevice() );
 
         double left, right, top, bottom;
         d_data->textEngine->textMargins(
@@ -0,0 +1,798 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_tiled_raster_data.h"
+#include <qfile.h>
+#include <qcache.h>
+#include <qmutex.h>
+#include <qvector.h>
+#include <qsharedpointer.h>
+#include <qnumeric.h>
+#include <qmath.h>
+#include <string.h>
+
+/*
+    File layout ( all values in host byte order ):
+
+    - QwtPyramidHeader
+    - level 0 .. numLevels - 1, each level divided into
+      numTilesY * numTilesX tiles in row major order.
+
+    A tile of level 0 consists of tileSize * tileSize values,
+    the tiles of all other levels consist of 3 planes ( mean, minimum,
+    maximum ) of tileSize * tileSize values. Cells outside of the
+    matrix are filled with NaN.
+ */
+
+static const quint32 qwtPyramidMagic = 0x51575450; // "QWTP"
+static const quint32 qwtPyramidVersion = 1;
+
+class QwtPyramidHeader
+{
+public:
+    quint32 magic;
+    quint32 version;
+
+    qint32 tileSize;
+    qint32 numColumns;
+    qint32 numRows;
+    qint32 numLevels;
+
+    qint32 reserved[10];
+};
+
+class QwtPyramidLayout
+{
+public:
+    class Level
+    {
+    public:
+        int numColumns;
+        int numRows;
+
+        int numTilesX;
+        int numTilesY;
+
+        int numPlanes;
+        qint64 offset;
+    };
+
+    QwtPyramidLayout():
+        tileSize( 0 ),
+        fileSize( 0 )
+    {
+    }
+
+    void init( int size, int numColumns, int numRows )
+    {
+        tileSize = size;
+        levels.clear();
+
+        qint64 offset = sizeof( QwtPyramidHeader );
+
+        int columns = numColumns;
+        int rows = numRows;
+
+        for ( int i = 0; ; i++ )
+        {
+            Level level;
+            level.numColumns = columns;
+            level.numRows = rows;
+            level.numTilesX = ( columns + tileSize - 1 ) / tileSize;
+            level.numTilesY = ( rows + tileSize - 1 ) / tileSize;
+            level.numPlanes = ( i == 0 ) ? 1 : 3;
+            level.offset = offset;
+
+            levels += level;
+
+            offset += qint64( level.numTilesX ) * level.numTilesY * tileBytes( i );
+
+            if ( columns <= tileSize && rows <= tileSize )
+                break;
+
+            columns = ( columns + 1 ) / 2;
+            rows = ( rows + 1 ) / 2;
+        }
+
+        fileSize = offset;
+    }
+
+    inline int numLevels() const
+    {
+        return levels.size();
+    }
+
+    inline qint64 tileBytes( int level ) const
+    {
+        return qint64( levels[level].numPlanes )
+            * tileSize * tileSize * sizeof( float );
+    }
+
+    inline qint64 tileOffset( int level, int tx, int ty ) const
+    {
+        const Level &l = levels[level];
+        return l.offset + ( qint64( ty ) * l.numTilesX + tx ) * tileBytes( level );
+    }
+
+    inline float *cell( uchar *mem, int level, int row, int col ) const
+    {
+        uchar *tile = mem + tileOffset( level, col / tileSize, row / tileSize );
+        return reinterpret_cast<float *>( tile )
+            + ( row % tileSize ) * tileSize + col % tileSize;
+    }
+
+    int tileSize;
+    qint64 fileSize;
+
+    QVector<Level> levels;
+};
+
+class QwtTiledRasterData::Tile
+{
+public:
+    Tile( QFile *file, uchar *memory ):
+        d_file( file ),
+        d_memory( memory )
+    {
+    }
+
+    ~Tile()
+    {
+        d_file->unmap( d_memory );
+    }
+
+    inline const float *values() const
+    {
+        return reinterpret_cast<const float *>( d_memory );
+    }
+
+private:
+    QFile *d_file;
+    uchar *d_memory;
+};
+
+class QwtTiledRasterData::PrivateData
+{
+public:
+    typedef QSharedPointer<Tile> TilePointer;
+
+    PrivateData():
+        aggregation( QwtTiledRasterData::Mean ),
+        dx( 0.0 ),
+        dy( 0.0 ),
+        level( 0 ),
+        pinnedX( 0 ),
+        pinnedY( 0 ),
+        pinnedColumns( 0 ),
+        pinnedRows( 0 )
+    {
+        cache.setMaxCost( 64 * 1024 ); // 64 MB
+    }
+
+    // needs to be called with the mutex being locked
+    TilePointer tile( int lvl, int tx, int ty )
+    {
+        const quint64 key = ( quint64( lvl ) << 56 )
+            | ( quint64( ty ) << 28 ) | quint64( tx );
+
+        TilePointer *cachedTile = cache.object( key );
+        if ( cachedTile )
+            return *cachedTile;
+
+        const qint64 size = layout.tileBytes( lvl );
+
+        uchar *mem = file.map( layout.tileOffset( lvl, tx, ty ), size );
+        if ( mem == NULL )
+            return TilePointer();
+
+        const TilePointer tile( new Tile( &file, mem ) );
+        cache.insert( key, new TilePointer( tile ), qMax( int( size / 1024 ), 1 ) );
+
+        return tile;
+    }
+
+    void unpinTiles()
+    {
+        pinnedValues.clear();
+        pinnedTiles.clear();
+
+        pinnedX = pinnedY = 0;
+        pinnedColumns = pinnedRows = 0;
+    }
+
+    void updateResolution()
+    {
+        dx = dy = 0.0;
+
+        if ( layout.numLevels() > 0 )
+        {
+            const QwtPyramidLayout::Level &l = layout.levels[0];
+
+            if ( intervals[Qt::XAxis].isValid() )
+                dx = intervals[Qt::XAxis].width() / l.numColumns;
+
+            if ( intervals[Qt::YAxis].isValid() )
+                dy = intervals[Qt::YAxis].width() / l.numRows;
+        }
+    }
+
+    QFile file;
+    QwtPyramidLayout layout;
+
+    QwtInterval intervals[3];
+    QwtTiledRasterData::Aggregation aggregation;
+
+    // size of a cell of level 0
+    double dx;
+    double dy;
+
+    QMutex mutex;
+    QCache<quint64, TilePointer> cache;
+
+    int level;
+
+    // the tiles covering the area of the current raster
+    int pinnedX;
+    int pinnedY;
+    int pinnedColumns;
+    int pinnedRows;
+
+    QVector<TilePointer> pinnedTiles;
+    QVector<const float *> pinnedValues;
+};
+
+//! Constructor
+QwtTiledRasterData::QwtTiledRasterData()
+{
+    d_data = new PrivateData();
+}
+
+//! Destructor
+QwtTiledRasterData::~QwtTiledRasterData()
+{
+    close();
+    delete d_data;
+}
+
+/*!
+   \brief Open a pyramid file
+
+   \param fileName Name of a file, that has been created by createPyramid()
+   \return true, when the file could be opened and has a valid format
+
+   \sa close(), isOpen(), createPyramid()
+*/
+bool QwtTiledRasterData::open( const QString &fileName )
+{
+    close();
+
+    QFile &file = d_data->file;
+
+    file.setFileName( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    QwtPyramidHeader header;
+
+    bool ok = file.read( reinterpret_cast<char *>( &header ),
+        sizeof( header ) ) == sizeof( header );
+
+    if ( ok )
+    {
+        ok = header.magic == qwtPyramidMagic
+            && header.version == qwtPyramidVersion
+            && header.tileSize > 0
+            && header.numColumns > 0 && header.numRows > 0;
+    }
+
+    if ( ok )
+    {
+        d_data->layout.init( header.tileSize,
+            header.numColumns, header.numRows );
+
+        ok = d_data->layout.numLevels() == header.numLevels
+            && file.size() >= d_data->layout.fileSize;
+    }
+
+    if ( !ok )
+    {
+        close();
+        return false;
+    }
+
+    d_data->updateResolution();
+    return true;
+}
+
+/*!
+   Close the pyramid file and clear the tile cache
+   \sa open()
+*/
+void QwtTiledRasterData::close()
+{
+    d_data->mutex.lock();
+
+    d_data->unpinTiles();
+    d_data->cache.clear();
+    d_data->level = 0;
+
+    d_data->mutex.unlock();
+
+    d_data->file.close();
+    d_data->layout = QwtPyramidLayout();
+
+    d_data->updateResolution();
+}
+
+/*!
+   \return true, when a pyramid file is open
+   \sa open(), close()
+*/
+bool QwtTiledRasterData::isOpen() const
+{
+    return d_data->layout.numLevels() > 0;
+}
+
+/*!
+   \return Name of the pyramid file
+   \sa open()
+*/
+QString QwtTiledRasterData::fileName() const
+{
+    return d_data->file.fileName();
+}
+
+/*!
+   \brief Create a pyramid file from a matrix of values
+
+   Beside the original values the file contains the downsampled levels
+   up to the level, that fits into a single tile. As each of them
+   stores 3 values per cell, the downsampled levels need about the
+   same space as the original values.
+
+   As the levels are calculated in a mapped file, the memory
+   footprint doesn't depend on the size of the matrix.
+
+   \param fileName Name of the file. An existing file will be overwritten
+   \param values Matrix of numRows * numColumns values in row major order.
+                 Unknown values can be indicated by NaN.
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param tileSize Number of rows/columns of a tile
+
+   \return true, when the file could be written
+
+   \sa open()
+*/
+bool QwtTiledRasterData::createPyramid( const QString &fileName,
+    const float *values, int numColumns, int numRows, int tileSize )
+{
+    if ( values == NULL || numColumns <= 0 || numRows <= 0 || tileSize <= 0 )
+        return false;
+
+    QwtPyramidLayout layout;
+    layout.init( tileSize, numColumns, numRows );
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadWrite | QIODevice::Truncate ) )
+        return false;
+
+    if ( !file.resize( layout.fileSize ) )
+        return false;
+
+    uchar *mem = file.map( 0, layout.fileSize );
+    if ( mem == NULL )
+        return false;
+
+    QwtPyramidHeader header;
+    memset( &header, 0, sizeof( header ) );
+
+    header.magic = qwtPyramidMagic;
+    header.version = qwtPyramidVersion;
+    header.tileSize = tileSize;
+    header.numColumns = numColumns;
+    header.numRows = numRows;
+    header.numLevels = layout.numLevels();
+
+    memcpy( mem, &header, sizeof( header ) );
+
+    const float nan = static_cast<float>( qQNaN() );
+    const int planeSize = tileSize * tileSize;
+
+    for ( int lvl = 0; lvl < layout.numLevels(); lvl++ )
+    {
+        const QwtPyramidLayout::Level &level = layout.levels[lvl];
+
+        for ( int row = 0; row < level.numTilesY * tileSize; row++ )
+        {
+            for ( int col = 0; col < level.numTilesX * tileSize; col++ )
+            {
+                float *cell = layout.cell( mem, lvl, row, col );
+
+                if ( lvl == 0 )
+                {
+                    if ( row < numRows && col < numColumns )
+                        *cell = values[ qint64( row ) * numColumns + col ];
+                    else
+                        *cell = nan;
+
+                    continue;
+                }
+
+                const QwtPyramidLayout::Level &below = layout.levels[lvl - 1];
+
+                double sum = 0.0;
+                int count = 0;
+
+                float min = nan;
+                float max = nan;
+
+                for ( int r = 2 * row; r <= 2 * row + 1; r++ )
+                {
+                    for ( int c = 2 * col; c <= 2 * col + 1; c++ )
+                    {
+                        if ( r >= below.numRows || c >= below.numColumns )
+                            continue;
+
+                        const float *src = layout.cell( mem, lvl - 1, r, c );
+
+                        const float mean = src[0];
+                        if ( qIsNaN( mean ) )
+                            continue;
+
+                        const float vMin = ( lvl == 1 ) ? mean : src[planeSize];
+                        const float vMax = ( lvl == 1 ) ? mean : src[2 * planeSize];
+
+                        if ( count == 0 || vMin < min )
+                            min = vMin;
+
+                        if ( count == 0 || vMax > max )
+                            max = vMax;
+
+                        sum += mean;
+                        count++;
+                    }
+                }
+
+                cell[0] = ( count > 0 ) ? static_cast<float>( sum / count ) : nan;
+                cell[planeSize] = min;
+                cell[2 * planeSize] = max;
+            }
+        }
+    }
+
+    file.unmap( mem );
+    file.close();
+
+    return true;
+}
+
+/*!
+   \brief Set the aggregation of the downsampled levels
+
+   \param aggregation Aggregation
+   \sa aggregation(), value()
+*/
+void QwtTiledRasterData::setAggregation( Aggregation aggregation )
+{
+    d_data->aggregation = aggregation;
+}
+
+/*!
+   \return Aggregation of the downsampled levels
+   \sa setAggregation()
+*/
+QwtTiledRasterData::Aggregation QwtTiledRasterData::aggregation() const
+{
+    return d_data->aggregation;
+}
+
+/*!
+   \brief Limit the size of the tile cache
+
+   Tiles, that are needed for the current raster ( see initRaster() )
+   are kept until discardRaster(), even if they exceed the limit.
+
+   \param kiloBytes Maximum size of all cached tiles in kilobytes.
+                    The default setting is 64 MB.
+   \sa maxCacheSize()
+*/
+void QwtTiledRasterData::setMaxCacheSize( int kiloBytes )
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->cache.setMaxCost( qMax( kiloBytes, 1 ) );
+}
+
+/*!
+   \return Maximum size of all cached tiles in kilobytes
+   \sa setMaxCacheSize()
+*/
+int QwtTiledRasterData::maxCacheSize() const
+{
+    return d_data->cache.maxCost();
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   Setting the bounding intervals for the X/Y axis is mandatory
+   to define the positions for the values of the matrix.
+
+   \param axis X, Y or Z axis
+   \param interval Interval
+
+   \sa QwtRasterData::interval()
+*/
+void QwtTiledRasterData::setInterval(
+    Qt::Axis axis, const QwtInterval &interval )
+{
+    if ( axis >= 0 && axis <= 2 )
+    {
+        d_data->intervals[axis] = interval;
+        d_data->updateResolution();
+    }
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval
+*/
+QwtInterval QwtTiledRasterData::interval( Qt::Axis axis ) const
+{
+    if ( axis >= 0 && axis <= 2 )
+        return d_data->intervals[ axis ];
+
+    return QwtInterval();
+}
+
+/*!
+   \return Number of columns of the original matrix
+   \sa numRows()
+*/
+int QwtTiledRasterData::numColumns() const
+{
+    if ( d_data->layout.numLevels() == 0 )
+        return 0;
+
+    return d_data->layout.levels[0].numColumns;
+}
+
+/*!
+   \return Number of rows of the original matrix
+   \sa numColumns()
+*/
+int QwtTiledRasterData::numRows() const
+{
+    if ( d_data->layout.numLevels() == 0 )
+        return 0;
+
+    return d_data->layout.levels[0].numRows;
+}
+
+/*!
+   \return Number of rows/columns of a tile
+   \sa createPyramid()
+*/
+int QwtTiledRasterData::tileSize() const
+{
+    return d_data->layout.tileSize;
+}
+
+/*!
+   \return Number of levels of the pyramid
+   \sa level()
+*/
+int QwtTiledRasterData::numLevels() const
+{
+    return d_data->layout.numLevels();
+}
+
+/*!
+   \return Level, that has been selected for the current raster.
+           Outside of initRaster()/discardRaster() the level is 0.
+   \sa initRaster()
+*/
+int QwtTiledRasterData::level() const
+{
+    return d_data->level;
+}
+
+/*!
+   \brief Calculate the pixel hint
+
+   pixelHint() returns the surrounding pixel of the top left value
+   of the original matrix. When the pixels of the matrix are smaller than
+   the pixels of the paint device the image is rendered in device
+   resolution and initRaster() selects the matching level.
+
+   \param area Requested area, ignored
+   \return Calculated hint
+
+   \sa initRaster()
+*/
+QRectF QwtTiledRasterData::pixelHint( const QRectF &area ) const
+{
+    Q_UNUSED( area )
+
+    QRectF rect;
+
+    const QwtInterval intervalX = interval( Qt::XAxis );
+    const QwtInterval intervalY = interval( Qt::YAxis );
+    if ( isOpen() && intervalX.isValid() && intervalY.isValid() )
+    {
+        rect = QRectF( intervalX.minValue(), intervalY.minValue(),
+            d_data->dx, d_data->dy );
+    }
+
+    return rect;
+}
+
+/*!
+  \brief Initialize a raster
+
+  The level is selected, where a cell is not larger than a pixel
+  of the raster. All tiles of this level, that intersect with the area
+  are loaded in advance.
+
+  \param area Area of the raster
+  \param raster Number of horizontal and vertical pixels
+
+  \sa discardRaster(), level(), value()
+*/
+void QwtTiledRasterData::initRaster( const QRectF &area, const QSize &raster )
+{
+    discardRaster();
+
+    const QwtInterval xInterval = interval( Qt::XAxis );
+    const QwtInterval yInterval = interval( Qt::YAxis );
+
+    if ( !isOpen() || !xInterval.isValid() || !yInterval.isValid()
+        || raster.isEmpty() || d_data->dx <= 0.0 || d_data->dy <= 0.0 )
+    {
+        return;
+    }
+
+    const QwtPyramidLayout &layout = d_data->layout;
+
+    const double ratio = qMin( area.width() / raster.width() / d_data->dx,
+        area.height() / raster.height() / d_data->dy );
+
+    int lvl = 0;
+    while ( lvl + 1 < layout.numLevels() && double( 1 << ( lvl + 1 ) ) <= ratio )
+        lvl++;
+
+    const QwtPyramidLayout::Level &level = layout.levels[lvl];
+
+    const double cellWidth = d_data->dx * ( 1 << lvl );
+    const double cellHeight = d_data->dy * ( 1 << lvl );
+
+    const QRectF r = area.normalized() & QRectF( xInterval.minValue(),
+        yInterval.minValue(), xInterval.width(), yInterval.width() );
+
+    if ( r.isEmpty() )
+        return;
+
+    const int col0 = qBound( 0,
+        int( ( r.left() - xInterval.minValue() ) / cellWidth ), level.numColumns - 1 );
+    const int col1 = qBound( 0,
+        int( ( r.right() - xInterval.minValue() ) / cellWidth ), level.numColumns - 1 );
+    const int row0 = qBound( 0,
+        int( ( r.top() - yInterval.minValue() ) / cellHeight ), level.numRows - 1 );
+    const int row1 = qBound( 0,
+        int( ( r.bottom() - yInterval.minValue() ) / cellHeight ), level.numRows - 1 );
+
+    QMutexLocker locker( &d_data->mutex );
+
+    d_data->level = lvl;
+
+    d_data->pinnedX = col0 / layout.tileSize;
+    d_data->pinnedY = row0 / layout.tileSize;
+    d_data->pinnedColumns = col1 / layout.tileSize - d_data->pinnedX + 1;
+    d_data->pinnedRows = row1 / layout.tileSize - d_data->pinnedY + 1;
+
+    const int numTiles = d_data->pinnedColumns * d_data->pinnedRows;
+    d_data->pinnedTiles.reserve( numTiles );
+    d_data->pinnedValues.reserve( numTiles );
+
+    for ( int ty = 0; ty < d_data->pinnedRows; ty++ )
+    {
+        for ( int tx = 0; tx < d_data->pinnedColumns; tx++ )
+        {
+            const PrivateData::TilePointer tile = d_data->tile( lvl,
+                d_data->pinnedX + tx, d_data->pinnedY + ty );
+
+            d_data->pinnedTiles += tile;
+            d_data->pinnedValues += tile.isNull() ? NULL : tile->values();
+        }
+    }
+}
+
+/*!
+  \brief Discard a raster
+
+  Releases the tiles, that have been loaded by initRaster() and
+  resets the level to 0.
+
+  \sa initRaster()
+*/
+void QwtTiledRasterData::discardRaster()
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    d_data->unpinTiles();
+    d_data->level = 0;
+}
+
+/*!
+   \return the value at a raster position
+
+   Between initRaster() and discardRaster() the value is taken from the
+   level, that has been selected for the raster. On all other levels
+   but level 0 the value depends on aggregation().
+
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+
+   \sa initRaster(), setAggregation()
+*/
+double QwtTiledRasterData::value( double x, double y ) const
+{
+    const QwtInterval xInterval = interval( Qt::XAxis );
+    const QwtInterval yInterval = interval( Qt::YAxis );
+
+    if ( !( xInterval.contains(x) && yInterval.contains(y) ) )
+        return qQNaN();
+
+    if ( !isOpen() || d_data->dx <= 0.0 || d_data->dy <= 0.0 )
+        return qQNaN();
+
+    const QwtPyramidLayout &layout = d_data->layout;
+
+    const int lvl = d_data->level;
+    const QwtPyramidLayout::Level &level = layout.levels[lvl];
+
+    int col = int( ( x - xInterval.minValue() ) / ( d_data->dx * ( 1 << lvl ) ) );
+    int row = int( ( y - yInterval.minValue() ) / ( d_data->dy * ( 1 << lvl ) ) );
+
+    // the maximum might be included in the intervals
+
+    if ( col >= level.numColumns )
+        col = level.numColumns - 1;
+
+    if ( row >= level.numRows )
+        row = level.numRows - 1;
+
+    const int tileSize = layout.tileSize;
+
+    int index = ( row % tileSize ) * tileSize + col % tileSize;
+    if ( lvl > 0 )
+        index += int( d_data->aggregation ) * tileSize * tileSize;
+
+    const int tx = col / tileSize - d_data->pinnedX;
+    const int ty = row / tileSize - d_data->pinnedY;
+
+    if ( tx >= 0 && tx < d_data->pinnedColumns
+        && ty >= 0 && ty < d_data->pinnedRows )
+    {
+        const float *values =
+            d_data->pinnedValues.constData()[ ty * d_data->pinnedColumns + tx ];
+
+        return values ? values[index] : qQNaN();
+    }
+
+    QMutexLocker locker( &d_data->mutex );
+
+    const PrivateData::TilePointer tile =
+        d_data->tile( lvl, col / tileSize, row / tileSize );
+
+    if ( tile.isNull() )
+        return qQNaN();
+
+    return tile->values()[index];
+}
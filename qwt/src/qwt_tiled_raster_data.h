@@ -0,0 +1,113 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TILED_RASTER_DATA_H
+#define QWT_TILED_RASTER_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+#include <qstring.h>
+
+/*!
+  \brief Raster data, that is read on demand from a tiled
+         multi-resolution file
+
+  QwtTiledRasterData is intended for matrices, that are too large to be
+  kept in memory. The values are stored in a file as a pyramid of levels,
+  where each level has half of the resolution of the level below.
+  Level 0 contains the original values, while each cell of the
+  other levels stores mean, minimum and maximum of the 2x2 cells
+  of the level below.
+
+  Each level is divided into tiles of tileSize() x tileSize() cells.
+  Tiles are mapped into memory ( QFile::map() ) when they are needed
+  and kept in a LRU cache, that is limited by maxCacheSize().
+  So the memory footprint depends on the size of the canvas and
+  the cache, but not on the size of the matrix.
+
+  In initRaster() the level is selected, that matches the resolution
+  of the requested raster. All tiles, that are covering the requested
+  area are loaded in advance, so that value() can be called
+  from parallel rendering threads without locking.
+
+  A pyramid file can be created from a matrix of values using
+  createPyramid(). As the matrix itself might be too large to fit
+  into memory, it is passed as a pointer, that might also be
+  a mapped file.
+
+  As with QwtMatrixRasterData the positions of the values are calculated
+  by dividing the bounding rectangle of the X/Y intervals into
+  equidistant rectangles ( pixels ).
+
+  \sa QwtMatrixRasterData, QwtPlotSpectrogram
+*/
+class QWT_EXPORT QwtTiledRasterData: public QwtRasterData
+{
+public:
+    /*!
+      \brief Aggregation of the values of the downsampled levels
+      The default setting is Mean.
+
+      \sa setAggregation()
+     */
+    enum Aggregation
+    {
+        //! Mean of the values covered by a cell
+        Mean,
+
+        //! Minimum of the values covered by a cell
+        Minimum,
+
+        //! Maximum of the values covered by a cell
+        Maximum
+    };
+
+    QwtTiledRasterData();
+    virtual ~QwtTiledRasterData();
+
+    bool open( const QString &fileName );
+    void close();
+
+    bool isOpen() const;
+    QString fileName() const;
+
+    static bool createPyramid( const QString &fileName,
+        const float *values, int numColumns, int numRows,
+        int tileSize = 256 );
+
+    void setAggregation( Aggregation );
+    Aggregation aggregation() const;
+
+    void setMaxCacheSize( int kiloBytes );
+    int maxCacheSize() const;
+
+    void setInterval( Qt::Axis, const QwtInterval & );
+    virtual QwtInterval interval( Qt::Axis ) const;
+
+    int numColumns() const;
+    int numRows() const;
+
+    int tileSize() const;
+    int numLevels() const;
+    int level() const;
+
+    virtual QRectF pixelHint( const QRectF & ) const;
+
+    virtual void initRaster( const QRectF &, const QSize& raster );
+    virtual void discardRaster();
+
+    virtual double value( double x, double y ) const;
+
+private:
+    class Tile;
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
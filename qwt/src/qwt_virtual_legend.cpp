@@ -0,0 +1,727 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_virtual_legend.h"
+#include "qwt_legend_label.h"
+#include "qwt_legend_data.h"
+#include "qwt_plot_item.h"
+#include "qwt_painter.h"
+#include "qwt_graphic.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+#include "qwt_legend_hash_p.h"
+#include <qapplication.h>
+#include <qabstractscrollarea.h>
+#include <qscrollbar.h>
+#include <qlayout.h>
+#include <qpainter.h>
+#include <qevent.h>
+#include <qhash.h>
+#include <qvector.h>
+
+namespace
+{
+    class Item
+    {
+    public:
+        QVariant itemInfo;
+        QList<QwtLegendData> data;
+
+        QVector<QSize> sizes;
+        QVector<bool> checked;
+
+        // changes, whenever data has been modified
+        uint revision;
+    };
+
+    class Entry
+    {
+    public:
+        Item *item;
+        int index;
+    };
+
+    class LabelSlot
+    {
+    public:
+        QwtLegendLabel *label;
+
+        // the entry, that is displayed by the label
+        Item *item;
+        int index;
+        uint revision;
+    };
+}
+
+class QwtVirtualLegend::PrivateData
+{
+public:
+    PrivateData():
+        itemMode( QwtLegendData::ReadOnly ),
+        maxColumns( 0 ),
+        revision( 0 ),
+        isDirty( false ),
+        isUpdatePending( false ),
+        view( NULL ),
+        sizeLabel( NULL )
+    {
+    }
+
+    ~PrivateData()
+    {
+        qDeleteAll( items );
+    }
+
+    Item *findItem( const QVariant &itemInfo ) const
+    {
+        const uint key = qwtItemHash( itemInfo );
+
+        for ( QMultiHash<uint, Item *>::const_iterator it = itemHash.find( key );
+            it != itemHash.end() && it.key() == key; ++it )
+        {
+            if ( it.value()->itemInfo == itemInfo )
+                return it.value();
+        }
+
+        return NULL;
+    }
+
+    void updateEntries()
+    {
+        if ( !isDirty )
+            return;
+
+        entries.clear();
+        cellSize = QSize( 0, 0 );
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            Item *item = items[i];
+
+            for ( int j = 0; j < item->data.size(); j++ )
+            {
+                Entry entry;
+                entry.item = item;
+                entry.index = j;
+
+                entries += entry;
+
+                cellSize = cellSize.expandedTo( item->sizes[j] );
+            }
+        }
+
+        isDirty = false;
+    }
+
+    int numColumns( int width ) const
+    {
+        const int numEntries = entries.size();
+        if ( numEntries == 0 )
+            return 0;
+
+        int numCols = 1;
+        if ( cellSize.width() > 0 )
+            numCols = qMax( width / cellSize.width(), 1 );
+
+        if ( maxColumns > 0 )
+            numCols = qMin( numCols, static_cast<int>( maxColumns ) );
+
+        return qMin( numCols, numEntries );
+    }
+
+    int numRows( int numCols ) const
+    {
+        if ( numCols <= 0 )
+            return 0;
+
+        return ( entries.size() + numCols - 1 ) / numCols;
+    }
+
+    QSize entrySize( const QwtLegendData &data ) const
+    {
+        // measuring the label without its icon, so that
+        // no pixmap needs to be rendered
+
+        QwtLegendData legendData = data;
+        legendData.setValue( QwtLegendData::IconRole, QVariant() );
+
+        sizeLabel->setItemMode( itemMode );
+        sizeLabel->setData( legendData );
+
+        QSize size = sizeLabel->sizeHint();
+
+        const QSizeF iconSize = data.icon().defaultSize();
+        if ( iconSize.width() > 0.0 )
+            size.rwidth() += qCeil( iconSize.width() ) + sizeLabel->spacing();
+
+        size.setHeight( qMax( size.height(), qCeil( iconSize.height() ) + 4 ) );
+
+        return size;
+    }
+
+    QwtLegendData::Mode itemMode;
+    uint maxColumns;
+
+    QList<Item *> items;
+    QMultiHash<uint, Item *> itemHash;
+    uint revision;
+
+    bool isDirty;
+    bool isUpdatePending;
+    QVector<Entry> entries;
+    QSize cellSize;
+
+    QAbstractScrollArea *view;
+    QList<LabelSlot> labels;
+    QwtLegendLabel *sizeLabel;
+};
+
+/*!
+  Constructor
+  \param parent Parent widget
+*/
+QwtVirtualLegend::QwtVirtualLegend( QWidget *parent ):
+    QwtAbstractLegend( parent )
+{
+    setFrameStyle( NoFrame );
+
+    d_data = new QwtVirtualLegend::PrivateData;
+
+    d_data->view = new QAbstractScrollArea( this );
+    d_data->view->setFrameStyle( NoFrame );
+    d_data->view->setFocusPolicy( Qt::NoFocus );
+    d_data->view->setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    d_data->view->setVerticalScrollBarPolicy( Qt::ScrollBarAsNeeded );
+
+    QWidget *viewport = d_data->view->viewport();
+    viewport->setObjectName( "QwtLegendView" );
+    viewport->setAutoFillBackground( false );
+    viewport->installEventFilter( this );
+
+    connect( d_data->view->verticalScrollBar(), SIGNAL( valueChanged( int ) ),
+        SLOT( updateLabels() ) );
+
+    d_data->sizeLabel = new QwtLegendLabel( this );
+    d_data->sizeLabel->hide();
+
+    QVBoxLayout *layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( d_data->view );
+}
+
+//! Destructor
+QwtVirtualLegend::~QwtVirtualLegend()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Set the maximum number of entries in a row
+
+  F.e when the maximum is set to 1 all items are aligned
+  vertically. 0 means unlimited
+
+  \param numColums Maximum number of entries in a row
+
+  \sa maxColumns()
+ */
+void QwtVirtualLegend::setMaxColumns( uint numColums )
+{
+    if ( numColums != d_data->maxColumns )
+    {
+        d_data->maxColumns = numColums;
+        invalidateLayout();
+    }
+}
+
+/*!
+  \return Maximum number of entries in a row
+  \sa setMaxColumns()
+ */
+uint QwtVirtualLegend::maxColumns() const
+{
+    return d_data->maxColumns;
+}
+
+/*!
+  \brief Set the default mode for legend labels
+
+  Legend labels will be constructed according to the
+  attributes in a QwtLegendData object. When it doesn't
+  contain a value for the QwtLegendData::ModeRole the
+  label will be initialized with the default mode of the legend.
+
+  \param mode Default item mode
+
+  \sa defaultItemMode(), QwtLegendData::value(), QwtPlotItem::legendData()
+  \note Changing the mode doesn't have any effect on existing labels.
+ */
+void QwtVirtualLegend::setDefaultItemMode( QwtLegendData::Mode mode )
+{
+    d_data->itemMode = mode;
+}
+
+/*!
+  \return Default item mode
+  \sa setDefaultItemMode()
+*/
+QwtLegendData::Mode QwtVirtualLegend::defaultItemMode() const
+{
+    return d_data->itemMode;
+}
+
+/*!
+  \return Number of entries of all plot items
+ */
+int QwtVirtualLegend::entryCount() const
+{
+    d_data->updateEntries();
+    return d_data->entries.size();
+}
+
+/*!
+  \brief Change the check state of a legend entry
+
+  As the labels are shared between the entries, the check state
+  of an entry in QwtLegendData::Checkable mode is stored by the legend.
+
+  \param itemInfo Info about an item
+  \param index Index of the entry
+  \param on Check state
+
+  \sa isChecked()
+ */
+void QwtVirtualLegend::setChecked(
+    const QVariant &itemInfo, int index, bool on )
+{
+    Item *item = d_data->findItem( itemInfo );
+    if ( item == NULL || index < 0 || index >= item->checked.size() )
+        return;
+
+    item->checked[index] = on;
+
+    for ( int i = 0; i < d_data->labels.size(); i++ )
+    {
+        const LabelSlot &slot = d_data->labels[i];
+        if ( slot.item == item && slot.index == index )
+            slot.label->setChecked( on );
+    }
+}
+
+/*!
+  \return Check state of a legend entry
+  \param itemInfo Info about an item
+  \param index Index of the entry
+
+  \sa setChecked()
+ */
+bool QwtVirtualLegend::isChecked( const QVariant &itemInfo, int index ) const
+{
+    const Item *item = d_data->findItem( itemInfo );
+    if ( item == NULL || index < 0 || index >= item->checked.size() )
+        return false;
+
+    return item->checked[index];
+}
+
+/*!
+  \return Vertical scrollbar
+ */
+QScrollBar *QwtVirtualLegend::verticalScrollBar() const
+{
+    return d_data->view->verticalScrollBar();
+}
+
+/*!
+  \brief Update the entries for an item
+
+  \param itemInfo Info for an item
+  \param legendData List of legend entries for the item
+ */
+void QwtVirtualLegend::updateLegend( const QVariant &itemInfo,
+    const QList<QwtLegendData> &legendData )
+{
+    Item *item = d_data->findItem( itemInfo );
+
+    if ( legendData.isEmpty() )
+    {
+        if ( item )
+        {
+            for ( int i = 0; i < d_data->labels.size(); i++ )
+            {
+                LabelSlot &slot = d_data->labels[i];
+                if ( slot.item == item )
+                {
+                    slot.item = NULL;
+                    slot.label->hide();
+                }
+            }
+
+            d_data->itemHash.remove( qwtItemHash( itemInfo ), item );
+            d_data->items.removeOne( item );
+            delete item;
+
+            invalidateLayout();
+        }
+
+        return;
+    }
+
+    if ( item == NULL )
+    {
+        item = new Item;
+        item->itemInfo = itemInfo;
+
+        d_data->items += item;
+        d_data->itemHash.insert( qwtItemHash( itemInfo ), item );
+    }
+
+    item->data = legendData;
+    item->revision = ++d_data->revision;
+
+    item->sizes.resize( legendData.size() );
+    for ( int i = 0; i < legendData.size(); i++ )
+        item->sizes[i] = d_data->entrySize( legendData[i] );
+
+    item->checked.resize( legendData.size() );
+
+    invalidateLayout();
+}
+
+void QwtVirtualLegend::invalidateLayout()
+{
+    d_data->isDirty = true;
+
+    updateGeometry();
+
+    if ( !d_data->isUpdatePending )
+    {
+        // many items are usually updated in a row, so we
+        // rearrange the labels only once
+
+        d_data->isUpdatePending = true;
+        QMetaObject::invokeMethod( this, "updateLabels", Qt::QueuedConnection );
+
+        if ( parentWidget() && parentWidget()->layout() == NULL )
+        {
+            /*
+              updateGeometry() doesn't post LayoutRequest in certain
+              situations, like when we are hidden. But we want the
+              parent widget notified, so it can show/hide the legend
+              depending on its items.
+             */
+            QApplication::postEvent( parentWidget(),
+                new QEvent( QEvent::LayoutRequest ) );
+        }
+    }
+}
+
+void QwtVirtualLegend::updateLabels()
+{
+    d_data->isUpdatePending = false;
+    d_data->updateEntries();
+
+    QWidget *viewport = d_data->view->viewport();
+    const QRect rect = viewport->contentsRect();
+    const QSize &cellSize = d_data->cellSize;
+
+    const int numEntries = d_data->entries.size();
+    const int numCols = d_data->numColumns( rect.width() );
+    const int numRows = d_data->numRows( numCols );
+
+    QScrollBar *scrollBar = d_data->view->verticalScrollBar();
+
+    // adjusting the range might change the value, what would
+    // call updateLabels() recursively
+
+    const bool blocked = scrollBar->blockSignals( true );
+
+    scrollBar->setRange( 0,
+        qMax( numRows * cellSize.height() - rect.height(), 0 ) );
+    scrollBar->setPageStep( rect.height() );
+    scrollBar->setSingleStep( qMax( cellSize.height(), 1 ) );
+
+    scrollBar->blockSignals( blocked );
+
+    const int offset = scrollBar->value();
+
+    int firstRow = 0;
+    int numLabels = 0;
+
+    if ( numRows > 0 && cellSize.height() > 0 )
+    {
+        firstRow = offset / cellSize.height();
+
+        const int lastRow = qMin( numRows - 1,
+            ( offset + rect.height() - 1 ) / cellSize.height() );
+
+        numLabels = qMax( lastRow - firstRow + 1, 0 ) * numCols;
+    }
+
+    while ( d_data->labels.size() < numLabels )
+    {
+        LabelSlot slot;
+        slot.label = new QwtLegendLabel( viewport );
+        slot.item = NULL;
+        slot.index = -1;
+        slot.revision = 0;
+
+        connect( slot.label, SIGNAL( clicked() ), SLOT( labelClicked() ) );
+        connect( slot.label, SIGNAL( checked( bool ) ),
+            SLOT( labelChecked( bool ) ) );
+
+        d_data->labels += slot;
+    }
+
+    for ( int i = 0; i < d_data->labels.size(); i++ )
+    {
+        LabelSlot &slot = d_data->labels[i];
+
+        const int entryIndex = firstRow * numCols + i;
+        if ( i >= numLabels || entryIndex >= numEntries )
+        {
+            slot.item = NULL;
+            slot.label->hide();
+            continue;
+        }
+
+        const Entry &entry = d_data->entries[entryIndex];
+
+        if ( slot.item != entry.item || slot.index != entry.index
+            || slot.revision != entry.item->revision )
+        {
+            // the icon of the entry is rendered here, when
+            // it becomes visible
+
+            slot.label->setItemMode( d_data->itemMode );
+            slot.label->setData( entry.item->data[entry.index] );
+            slot.label->setChecked( entry.item->checked[entry.index] );
+
+            slot.item = entry.item;
+            slot.index = entry.index;
+            slot.revision = entry.item->revision;
+        }
+
+        const int row = firstRow + i / numCols;
+        const int col = i % numCols;
+
+        slot.label->setGeometry( rect.x() + col * cellSize.width(),
+            rect.y() + row * cellSize.height() - offset,
+            cellSize.width(), cellSize.height() );
+
+        slot.label->show();
+    }
+}
+
+void QwtVirtualLegend::labelClicked()
+{
+    for ( int i = 0; i < d_data->labels.size(); i++ )
+    {
+        const LabelSlot &slot = d_data->labels[i];
+        if ( slot.label == sender() )
+        {
+            if ( slot.item )
+                Q_EMIT clicked( slot.item->itemInfo, slot.index );
+
+            return;
+        }
+    }
+}
+
+void QwtVirtualLegend::labelChecked( bool on )
+{
+    for ( int i = 0; i < d_data->labels.size(); i++ )
+    {
+        const LabelSlot &slot = d_data->labels[i];
+        if ( slot.label == sender() )
+        {
+            if ( slot.item )
+            {
+                slot.item->checked[slot.index] = on;
+                Q_EMIT checked( slot.item->itemInfo, on, slot.index );
+            }
+
+            return;
+        }
+    }
+}
+
+/*!
+  \return Size hint
+  \sa heightForWidth()
+ */
+QSize QwtVirtualLegend::sizeHint() const
+{
+    d_data->updateEntries();
+
+    const int numEntries = d_data->entries.size();
+    if ( numEntries == 0 )
+        return QSize( 0, 0 );
+
+    int numCols = numEntries;
+    if ( d_data->maxColumns > 0 )
+        numCols = qMin( numCols, static_cast<int>( d_data->maxColumns ) );
+
+    const int numRows = d_data->numRows( numCols );
+
+    QSize hint( numCols * d_data->cellSize.width(),
+        numRows * d_data->cellSize.height() );
+
+    hint += QSize( 2 * frameWidth(), 2 * frameWidth() );
+
+    return hint;
+}
+
+/*!
+  \return The preferred height, for a width.
+  \param width Width
+ */
+int QwtVirtualLegend::heightForWidth( int width ) const
+{
+    d_data->updateEntries();
+
+    width -= 2 * frameWidth();
+
+    const int numRows = d_data->numRows( d_data->numColumns( width ) );
+
+    int h = numRows * d_data->cellSize.height();
+    if ( h >= 0 )
+        h += 2 * frameWidth();
+
+    return h;
+}
+
+/*!
+  Handle resize events of the viewport
+
+  \param object Object to be filtered
+  \param event Event
+
+  \return Forwarded to QwtAbstractLegend::eventFilter()
+ */
+bool QwtVirtualLegend::eventFilter( QObject *object, QEvent *event )
+{
+    if ( object == d_data->view->viewport() )
+    {
+        if ( event->type() == QEvent::Resize )
+            updateLabels();
+    }
+
+    return QwtAbstractLegend::eventFilter( object, event );
+}
+
+/*!
+  Return the extent, that is needed for the scrollbar
+
+  \param orientation Orientation
+  \return The width of the vertical scrollbar for Qt::Horizontal and 0
+          for Qt::Vertical, as the legend is not scrolled horizontally
+ */
+int QwtVirtualLegend::scrollExtent( Qt::Orientation orientation ) const
+{
+    int extent = 0;
+
+    if ( orientation == Qt::Horizontal )
+        extent = verticalScrollBar()->sizeHint().width();
+
+    return extent;
+}
+
+/*!
+  \return True, when no plot item is inserted
+ */
+bool QwtVirtualLegend::isEmpty() const
+{
+    return d_data->items.isEmpty();
+}
+
+/*!
+  Render the legend into a given rectangle.
+
+  All entries are rendered - not only the visible ones.
+
+  \param painter Painter
+  \param rect Bounding rectangle
+  \param fillBackground When true, fill rect with the widget background
+
+  \sa renderLegend() is used by QwtPlotRenderer - not by QwtVirtualLegend itself
+ */
+void QwtVirtualLegend::renderLegend( QPainter *painter,
+    const QRectF &rect, bool fillBackground ) const
+{
+    d_data->updateEntries();
+
+    if ( d_data->entries.isEmpty() )
+        return;
+
+    if ( fillBackground )
+    {
+        if ( autoFillBackground() ||
+            testAttribute( Qt::WA_StyledBackground ) )
+        {
+            QwtPainter::drawBackgound( painter, rect, this );
+        }
+    }
+
+    int left, right, top, bottom;
+    getContentsMargins( &left, &top, &right, &bottom );
+
+    QRect layoutRect;
+    layoutRect.setLeft( qCeil( rect.left() ) + left );
+    layoutRect.setTop( qCeil( rect.top() ) + top );
+    layoutRect.setRight( qFloor( rect.right() ) - right );
+    layoutRect.setBottom( qFloor( rect.bottom() ) - bottom );
+
+    const QSize &cellSize = d_data->cellSize;
+    const int numCols = d_data->numColumns( layoutRect.width() );
+
+    const QwtLegendLabel *label = d_data->sizeLabel;
+
+    painter->setFont( label->font() );
+    painter->setPen( label->palette().color( QPalette::Text ) );
+
+    for ( int i = 0; i < d_data->entries.size(); i++ )
+    {
+        const Entry &entry = d_data->entries[i];
+        const QwtLegendData &data = entry.item->data[entry.index];
+
+        const QRectF entryRect(
+            layoutRect.x() + ( i % numCols ) * cellSize.width(),
+            layoutRect.y() + ( i / numCols ) * cellSize.height(),
+            cellSize.width(), cellSize.height() );
+
+        if ( entryRect.top() > layoutRect.bottom() )
+            break;
+
+        painter->save();
+        painter->setClipRect( entryRect, Qt::IntersectClip );
+
+        // icon
+
+        const QwtGraphic icon = data.icon();
+        const QSizeF sz = icon.defaultSize();
+
+        const QRectF iconRect( entryRect.x() + label->margin(),
+            entryRect.center().y() - 0.5 * sz.height(),
+            sz.width(), sz.height() );
+
+        icon.render( painter, iconRect, Qt::KeepAspectRatio );
+
+        // title
+
+        QRectF titleRect = entryRect;
+        titleRect.setX( iconRect.right() + 2 * label->spacing() );
+
+        QwtText title = data.title();
+        title.setRenderFlags( Qt::AlignLeft | Qt::AlignVCenter );
+        title.draw( painter, titleRect );
+
+        painter->restore();
+    }
+}
@@ -0,0 +1,106 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_VIRTUAL_LEGEND_H
+#define QWT_VIRTUAL_LEGEND_H
+
+#include "qwt_global.h"
+#include "qwt_abstract_legend.h"
+#include <qvariant.h>
+
+class QScrollBar;
+
+/*!
+  \brief A legend for many entries
+
+  QwtLegend creates a QwtLegendLabel for each entry, what becomes
+  slow for plots with thousands of items. QwtVirtualLegend only
+  stores the legend data and creates labels for the rows, that are
+  visible in its viewport. When scrolling, these labels are reused
+  for other entries. As QwtLegendLabel converts the icon of an entry into
+  a pixmap, icons are rendered for the visible entries only.
+
+  All entries are displayed in cells of the same size, that are arranged
+  in up to maxColumns() columns. The legend can be scrolled vertically.
+
+  \sa QwtLegend, QwtLegendLabel, QwtPlot::insertLegend()
+*/
+class QWT_EXPORT QwtVirtualLegend: public QwtAbstractLegend
+{
+    Q_OBJECT
+
+public:
+    explicit QwtVirtualLegend( QWidget *parent = NULL );
+    virtual ~QwtVirtualLegend();
+
+    void setMaxColumns( uint numColums );
+    uint maxColumns() const;
+
+    void setDefaultItemMode( QwtLegendData::Mode );
+    QwtLegendData::Mode defaultItemMode() const;
+
+    int entryCount() const;
+
+    void setChecked( const QVariant &itemInfo, int index, bool on );
+    bool isChecked( const QVariant &itemInfo, int index ) const;
+
+    QScrollBar *verticalScrollBar() const;
+
+    virtual QSize sizeHint() const;
+    virtual int heightForWidth( int width ) const;
+
+    virtual void renderLegend( QPainter *,
+        const QRectF &, bool fillBackground ) const;
+
+    virtual bool isEmpty() const;
+    virtual int scrollExtent( Qt::Orientation ) const;
+
+    virtual bool eventFilter( QObject *, QEvent * );
+
+Q_SIGNALS:
+    /*!
+      A signal which is emitted when the user has clicked on
+      a legend label, which is in QwtLegendData::Clickable mode.
+
+      \param itemInfo Info for the item item of the
+                      selected legend item
+      \param index Index of the legend entry in the list of entries
+                   that are associated with the plot item
+     */
+    void clicked( const QVariant &itemInfo, int index );
+
+    /*!
+      A signal which is emitted when the user has clicked on
+      a legend label, which is in QwtLegendData::Checkable mode
+
+      \param itemInfo Info for the item of the
+                      selected legend label
+      \param index Index of the legend entry in the list of entries
+                   that are associated with the plot item
+      \param on True when the legend label is checked
+     */
+    void checked( const QVariant &itemInfo, bool on, int index );
+
+public Q_SLOTS:
+    virtual void updateLegend( const QVariant &,
+        const QList<QwtLegendData> & );
+
+private Q_SLOTS:
+    void updateLabels();
+    void labelClicked();
+    void labelChecked( bool );
+
+private:
+    void invalidateLayout();
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -111,8 +111,11 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.h \
         qwt_legend_data.h \
         qwt_legend_label.h \
+        qwt_virtual_legend.h \
         qwt_plot.h \
         qwt_plot_renderer.h \
+        qwt_plot_scene.h \
+        qwt_plot_matrix.h \
         qwt_plot_curve.h \
         qwt_plot_dict.h \
         qwt_plot_directpainter.h \
@@ -145,13 +148,20 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_point_mapper.h \
         qwt_raster_data.h \
         qwt_matrix_raster_data.h \
+        qwt_tiled_raster_data.h \
         qwt_sampling_thread.h \
         qwt_samples.h \
         qwt_series_data.h \
         qwt_series_store.h \
         qwt_point_data.h \
+        qwt_histogram_data.h \
         qwt_scale_widget.h 
 
+    # internal headers, that are not installed
+    PRIVATE_HEADERS += \
+        qwt_legend_hash_p.h \
+        qwt_scale_map_p.h
+
     SOURCES += \
         qwt_curve_fitter.cpp \
         qwt_spline_curve_fitter.cpp \
@@ -160,8 +170,11 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.cpp \
         qwt_legend_data.cpp \
         qwt_legend_label.cpp \
+        qwt_virtual_legend.cpp \
         qwt_plot.cpp \
         qwt_plot_renderer.cpp \
+        qwt_plot_scene.cpp \
+        qwt_plot_matrix.cpp \
         qwt_plot_xml.cpp \
         qwt_plot_axis.cpp \
         qwt_plot_curve.cpp \
@@ -196,9 +209,11 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_point_mapper.cpp \
         qwt_raster_data.cpp \
         qwt_matrix_raster_data.cpp \
+        qwt_tiled_raster_data.cpp \
         qwt_sampling_thread.cpp \
         qwt_series_data.cpp \
         qwt_point_data.cpp \
+        qwt_histogram_data.cpp \
         qwt_scale_widget.cpp
 
     contains(QWT_CONFIG, QwtOpenGL) {
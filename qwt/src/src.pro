@@ -65,6 +65,9 @@ else {
     INSTALLS += headers
 }
 
+# added after the install directives to keep them out of the API
+HEADERS += $${PRIVATE_HEADERS}
+
 contains(QWT_CONFIG, QwtPkgConfig) {
 
     CONFIG     += create_pc create_prl no_install_prl
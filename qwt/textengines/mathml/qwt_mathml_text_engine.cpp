@@ -11,17 +11,103 @@
 
 #include <qstring.h>
 #include <qpainter.h>
+#include <qcache.h>
+#include <qmutex.h>
 #include "qwt_mathml_text_engine.h"
 #include "qwt_mml_document.h"
 
+static inline QString qwtCacheKey( const QString &text, qreal pointSize )
+{
+    return QString::number( pointSize ) + QLatin1Char( '|' ) + text;
+}
+
+static QwtMathMLDocument *qwtCreateDocument(
+    const QString &text, qreal pointSize )
+{
+    QwtMathMLDocument *doc = new QwtMathMLDocument();
+    doc->setContent( text );
+    doc->setBaseFontPointSize( pointSize );
+
+    return doc;
+}
+
+class QwtMathMLTextEngine::PrivateData
+{
+public:
+    PrivateData():
+        cache( 100 )
+    {
+    }
+
+    /*
+      As painting a document modifies it, documents are
+      removed from the cache while they are painted.
+     */
+    QwtMathMLDocument *takeDocument( const QString &key )
+    {
+        QMutexLocker locker( &mutex );
+        return cache.take( key );
+    }
+
+    void insertDocument( const QString &key, QwtMathMLDocument *doc )
+    {
+        QMutexLocker locker( &mutex );
+        cache.insert( key, doc );
+    }
+
+    bool documentSize( const QString &key, QSizeF &size )
+    {
+        QMutexLocker locker( &mutex );
+
+        const QwtMathMLDocument *doc = cache.object( key );
+        if ( doc )
+            size = doc->size();
+
+        return doc != NULL;
+    }
+
+    QMutex mutex;
+    QCache<QString, QwtMathMLDocument> cache;
+};
+
 //! Constructor
 QwtMathMLTextEngine::QwtMathMLTextEngine()
 {
+    d_data = new PrivateData;
 }
 
 //! Destructor
 QwtMathMLTextEngine::~QwtMathMLTextEngine()
 {
+    delete d_data;
+}
+
+/*!
+  \brief Set the maximum number of documents in the cache
+
+  The engine keeps the parsed and laid out documents of the
+  texts, that have been rendered recently. The least
+  recently used documents are removed first.
+
+  \param numDocuments Maximum number of documents.
+                      0 disables the cache.
+
+  \sa cacheSize()
+*/
+void QwtMathMLTextEngine::setCacheSize( int numDocuments )
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->cache.setMaxCost( qMax( numDocuments, 0 ) );
+}
+
+/*!
+  \return Maximum number of documents in the cache
+  \sa setCacheSize()
+*/
+int QwtMathMLTextEngine::cacheSize() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->cache.maxCost();
 }
 
 /*!
@@ -54,17 +140,16 @@ QSizeF QwtMathMLTextEngine::textSize( const QFont &font,
 {
     Q_UNUSED( flags );
 
-    static QString t;
-    static QSizeF sz;
+    const QString key = qwtCacheKey( text, font.pointSizeF() );
 
-    if ( text != t )
+    QSizeF sz;
+    if ( !d_data->documentSize( key, sz ) )
     {
-        QwtMathMLDocument doc;
-        doc.setContent( text );
-        doc.setBaseFontPointSize( font.pointSizeF() );
+        QwtMathMLDocument *doc =
+            qwtCreateDocument( text, font.pointSizeF() );
 
-        sz = doc.size();
-        t = text;
+        sz = doc->size();
+        d_data->insertDocument( key, doc );
     }
 
     return sz;
@@ -95,11 +180,14 @@ void QwtMathMLTextEngine::textMargins( const QFont &, const QString &,
 void QwtMathMLTextEngine::draw( QPainter *painter, const QRectF &rect,
     int flags, const QString& text ) const
 {
-    QwtMathMLDocument doc;
-    doc.setContent( text );
-    doc.setBaseFontPointSize( painter->font().pointSizeF() );
+    const qreal pointSize = painter->font().pointSizeF();
+    const QString key = qwtCacheKey( text, pointSize );
 
-    const QSizeF docSize = doc.size();
+    QwtMathMLDocument *doc = d_data->takeDocument( key );
+    if ( doc == NULL )
+        doc = qwtCreateDocument( text, pointSize );
+
+    const QSizeF docSize = doc->size();
 
     QPointF pos = rect.topLeft();
     if ( rect.width() > docSize.width() )
@@ -117,7 +205,9 @@ void QwtMathMLTextEngine::draw( QPainter *painter, const QRectF &rect,
             pos.setY( rect.center().y() - docSize.height() / 2 );
     }
 
-    doc.paint( painter, pos.toPoint() );
+    doc->paint( painter, pos.toPoint() );
+
+    d_data->insertDocument( key, doc );
 }
 
 /*!
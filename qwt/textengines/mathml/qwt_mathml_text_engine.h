@@ -25,6 +25,11 @@
 QwtText::setTextEngine(QwtText::MathMLText, new QwtMathMLTextEngine());
   \endverbatim
 
+  Parsing and laying out a MathML document is expensive. So the engine
+  keeps the most recently used documents - identified by the text and
+  the point size of the font - in a cache, that can be accessed from
+  different threads.
+
   \sa QwtTextEngine, QwtText::setTextEngine
   \warning Unfortunately the MathML renderer doesn't support rotating of texts.
 */
@@ -48,6 +53,13 @@ public:
 
     virtual void textMargins( const QFont &, const QString &,
         double &left, double &right, double &top, double &bottom ) const;
+
+    void setCacheSize( int );
+    int cacheSize() const;
+
+private:
+    class PrivateData;
+    PrivateData *d_data;
 };
 
 #endif